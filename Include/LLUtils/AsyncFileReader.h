@@ -0,0 +1,481 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/FileHelper.h>
+#include <LLUtils/Platform.h>
+#include <LLUtils/StringDefs.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #if __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+    #endif
+#endif
+
+// Linked reads of a file opened in the same chain need Linux 5.18 (IORING_FEAT_LINKED_FILE) and statx from glibc 2.28,
+// older headers fall back to the thread pool.
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX && defined(IORING_FEAT_LINKED_FILE) && defined(STATX_SIZE) && defined(__NR_io_uring_setup)
+    #define LLUTILS_ASYNC_FILE_READER_IO_URING 1
+#else
+    #define LLUTILS_ASYNC_FILE_READER_IO_URING 0
+#endif
+
+namespace LLUtils
+{
+    // Reads many whole files concurrently.
+    // On Linux the stat, open, read and close calls of all files are batched through io_uring, driven with raw
+    // syscalls so no library is needed. Where io_uring is unavailable (old kernels, seccomp filters, other platforms)
+    // the files are read by a pool of threads.
+    class AsyncFileReader
+    {
+    public:
+        struct Result
+        {
+            LLUtils::Buffer data;
+            int error{}; // 0 on success, otherwise the OS error code (errno on Linux).
+        };
+
+        // queueDepth - maximum number of operations in flight, each file takes three.
+        // threads - number of threads used when io_uring is unavailable, 0 means the number of hardware threads.
+        explicit AsyncFileReader(unsigned int queueDepth = 256, unsigned int threads = 0)
+            : fThreads(threads != 0 ? threads : (std::max)(1u, std::thread::hardware_concurrency()))
+        {
+#if LLUTILS_ASYNC_FILE_READER_IO_URING
+            fRing = IORing::Create((std::max)(queueDepth, 4u));
+#else
+            (void)queueDepth;
+#endif
+        }
+
+        bool IsUsingIOUring() const
+        {
+#if LLUTILS_ASYNC_FILE_READER_IO_URING
+            return fRing != nullptr;
+#else
+            return false;
+#endif
+        }
+
+        // Read the files, results are in the order of 'filePaths'.
+        std::vector<Result> ReadAll(std::span<const native_string_type> filePaths)
+        {
+            std::vector<Result> results(filePaths.size());
+#if LLUTILS_ASYNC_FILE_READER_IO_URING
+            if (fRing != nullptr)
+            {
+                ReadAllIORing(filePaths, results);
+                return results;
+            }
+#endif
+            ReadAllThreaded(filePaths, results);
+            return results;
+        }
+
+    private:
+        void ReadAllThreaded(std::span<const native_string_type> filePaths, std::vector<Result>& results) const
+        {
+            std::atomic<size_t> next = 0;
+            auto worker = [&]
+            {
+                for (size_t i = next++; i < filePaths.size(); i = next++)
+                    ReadFileSync(filePaths[i], results[i]);
+            };
+
+            std::vector<std::thread> threads;
+            const size_t threadCount = std::min<size_t>(fThreads, filePaths.size());
+            try
+            {
+                for (size_t i = 1; i < threadCount; i++)
+                    threads.emplace_back(worker);
+            }
+            catch (...)
+            {
+                // Out of threads, the ones already started and this one read the remaining files.
+            }
+
+            worker();
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        static void ReadFileSync(const native_string_type& filePath, Result& result)
+        {
+            File::NativeFile file(filePath);
+            if (file.IsOpen() == false)
+            {
+                result.error = file.GetError();
+                return;
+            }
+
+            try
+            {
+                File::ReadToEnd(file, result.data);
+            }
+            catch (const std::runtime_error&)
+            {
+                // Only failed system calls are reported as results.
+                if (file.GetError() == 0)
+                    throw;
+                result.error = file.GetError();
+                result.data.Resize(0);
+            }
+        }
+
+#if LLUTILS_ASYNC_FILE_READER_IO_URING
+        // Minimal io_uring over the raw system calls.
+        class IORing
+        {
+        public:
+            static std::unique_ptr<IORing> Create(unsigned int entries)
+            {
+                io_uring_params params{};
+                const int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                if (fd == -1)
+                    return nullptr;
+
+                if ((params.features & IORING_FEAT_LINKED_FILE) == 0)
+                {
+                    close(fd);
+                    return nullptr;
+                }
+
+                std::unique_ptr<IORing> ring(new IORing(fd));
+                return ring->Map(params) && ring->RegisterFileSlots() ? std::move(ring) : nullptr;
+            }
+
+            IORing(const IORing&) = delete;
+            IORing& operator=(const IORing&) = delete;
+
+            ~IORing()
+            {
+                if (fSQEs != nullptr)
+                    munmap(fSQEs, fSQEsSize);
+                if (fCQRing != nullptr && fCQRing != fSQRing)
+                    munmap(fCQRing, fCQRingSize);
+                if (fSQRing != nullptr)
+                    munmap(fSQRing, fSQRingSize);
+                close(fFd);
+            }
+
+            // Fixed file slots, one per file chain, see ReadAllIORing.
+            unsigned int GetFileSlots() const
+            {
+                return fSQEntries / 3;
+            }
+
+            // A zeroed submission entry, or nullptr if the submission queue is full.
+            // The entry is handed to the kernel by the next SubmitAndWait, after the caller has filled it.
+            io_uring_sqe* GetSQE()
+            {
+                if (fSQLocalTail - std::atomic_ref<unsigned int>(*fSQHead).load(std::memory_order_acquire) >= fSQEntries)
+                    return nullptr;
+
+                const unsigned int index = fSQLocalTail & fSQMask;
+                fSQArray[index] = index;
+                io_uring_sqe* sqe = &fSQEs[index];
+                memset(sqe, 0, sizeof(io_uring_sqe));
+                fSQLocalTail++;
+                return sqe;
+            }
+
+            // Submit the queued entries and wait for at least 'waitFor' completions.
+            void SubmitAndWait(unsigned int waitFor)
+            {
+                // Publish the filled entries, the release store orders their contents before the new tail.
+                fPendingSubmit += fSQLocalTail - *fSQTail;
+                std::atomic_ref<unsigned int>(*fSQTail).store(fSQLocalTail, std::memory_order_release);
+                for (;;)
+                {
+                    const long submitted = syscall(__NR_io_uring_enter, fFd, fPendingSubmit, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+                    if (submitted >= 0)
+                    {
+                        fPendingSubmit -= static_cast<unsigned int>(submitted);
+                        return;
+                    }
+                    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                        throw std::runtime_error("io_uring_enter failed");
+                }
+            }
+
+            // Invoke 'func(const io_uring_cqe&)' for each available completion.
+            template <typename Func>
+            void ForEachCompletion(Func&& func)
+            {
+                unsigned int head = *fCQHead;
+                const unsigned int tail = std::atomic_ref<unsigned int>(*fCQTail).load(std::memory_order_acquire);
+                for (; head != tail; head++)
+                    func(fCQEs[head & fCQMask]);
+                std::atomic_ref<unsigned int>(*fCQHead).store(head, std::memory_order_release);
+            }
+
+        private:
+            IORing(int fd) : fFd(fd)
+            {
+
+            }
+
+            bool Map(const io_uring_params& params)
+            {
+                fSQEntries = params.sq_entries;
+                fSQRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+                fCQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                fSQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+
+                const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMap)
+                    fSQRingSize = fCQRingSize = (std::max)(fSQRingSize, fCQRingSize);
+
+                fSQRing = MapRegion(fSQRingSize, IORING_OFF_SQ_RING);
+                fCQRing = singleMap ? fSQRing : MapRegion(fCQRingSize, IORING_OFF_CQ_RING);
+                fSQEs = static_cast<io_uring_sqe*>(static_cast<void*>(MapRegion(fSQEsSize, IORING_OFF_SQES)));
+                if (fSQRing == nullptr || fCQRing == nullptr || fSQEs == nullptr)
+                    return false;
+
+                LLUTILS_DISABLE_WARNING_PUSH
+                LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+                fSQHead = reinterpret_cast<unsigned int*>(fSQRing + params.sq_off.head);
+                fSQTail = reinterpret_cast<unsigned int*>(fSQRing + params.sq_off.tail);
+                fSQMask = *reinterpret_cast<unsigned int*>(fSQRing + params.sq_off.ring_mask);
+                fSQArray = reinterpret_cast<unsigned int*>(fSQRing + params.sq_off.array);
+                fSQLocalTail = *fSQTail;
+                fCQHead = reinterpret_cast<unsigned int*>(fCQRing + params.cq_off.head);
+                fCQTail = reinterpret_cast<unsigned int*>(fCQRing + params.cq_off.tail);
+                fCQMask = *reinterpret_cast<unsigned int*>(fCQRing + params.cq_off.ring_mask);
+                fCQEs = reinterpret_cast<io_uring_cqe*>(fCQRing + params.cq_off.cqes);
+                LLUTILS_DISABLE_WARNING_POP
+                return true;
+            }
+
+            // An empty fixed file table, openat fills a slot and close empties it.
+            bool RegisterFileSlots()
+            {
+                const std::vector<int> slots(GetFileSlots(), -1);
+                return syscall(__NR_io_uring_register, fFd, IORING_REGISTER_FILES, slots.data(), static_cast<unsigned int>(slots.size())) != -1;
+            }
+
+            std::byte* MapRegion(size_t size, off_t offset) const
+            {
+                void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fFd, offset);
+                return region == MAP_FAILED ? nullptr : static_cast<std::byte*>(region);
+            }
+
+        private:
+            int fFd;
+            unsigned int fSQEntries{};
+            unsigned int fPendingSubmit{};
+            size_t fSQRingSize{};
+            size_t fCQRingSize{};
+            size_t fSQEsSize{};
+            std::byte* fSQRing = nullptr;
+            std::byte* fCQRing = nullptr;
+            io_uring_sqe* fSQEs = nullptr;
+            unsigned int* fSQHead = nullptr;
+            unsigned int* fSQTail = nullptr;
+            // Entries handed out by GetSQE, published to fSQTail on submit.
+            unsigned int fSQLocalTail{};
+            unsigned int fSQMask{};
+            unsigned int* fSQArray = nullptr;
+            unsigned int* fCQHead = nullptr;
+            unsigned int* fCQTail = nullptr;
+            unsigned int fCQMask{};
+            io_uring_cqe* fCQEs = nullptr;
+        };
+
+        // Files are read in batches of one file per fixed file slot, in two passes with a single wait each:
+        // statx every path to size its buffer, then per file open -> read -> close linked in one chain on its slot,
+        // so no descriptor is returned to user space and no other system call is made.
+        // Files that aren't regular, report no size (procfs files return short reads before their end), don't fit one read,
+        // or grew past their size are read synchronously afterwards.
+        enum class Operation : uint64_t { Stat, Open, Read, Close };
+
+        // A single read returns at most 2 GB, leave larger files to the synchronous path.
+        static constexpr size_t MaxChainedRead = size_t{ 1 } << 30;
+
+        static uint64_t MakeUserData(size_t index, Operation operation)
+        {
+            return (static_cast<uint64_t>(index) << 2) | static_cast<uint64_t>(operation);
+        }
+
+        void ReadAllIORing(std::span<const native_string_type> filePaths, std::vector<Result>& results)
+        {
+            IORing& ring = *fRing;
+            const size_t batchSize = ring.GetFileSlots();
+            std::vector<struct statx> stats(batchSize);
+            std::vector<size_t> readSizes(batchSize);
+            std::vector<size_t> readSync;
+            size_t first = 0;
+            unsigned int operationsInFlight = 0;
+
+            auto queue = [&](size_t index, Operation operation) -> io_uring_sqe&
+            {
+                io_uring_sqe* sqe = ring.GetSQE();
+                if (sqe == nullptr)
+                {
+                    // Hand the queued entries to the kernel to make room.
+                    ring.SubmitAndWait(0);
+                    sqe = ring.GetSQE();
+                    if (sqe == nullptr)
+                        throw std::runtime_error("io_uring submission queue is full");
+                }
+                sqe->user_data = MakeUserData(index, operation);
+                operationsInFlight++;
+                return *sqe;
+            };
+
+            auto queueChain = [&](size_t index)
+            {
+                const unsigned int slot = static_cast<unsigned int>(index - first);
+                io_uring_sqe& open = queue(index, Operation::Open);
+                open.opcode = IORING_OP_OPENAT;
+                open.flags = IOSQE_IO_LINK;
+                open.fd = AT_FDCWD;
+                open.addr = reinterpret_cast<uint64_t>(filePaths[index].c_str());
+                // Direct descriptors live only in the ring, O_CLOEXEC doesn't apply and is rejected.
+                open.open_flags = O_RDONLY;
+                open.file_index = slot + 1;
+
+                // Hard linked so a short read, the normal outcome with the spare byte, doesn't cancel the close.
+                io_uring_sqe& read = queue(index, Operation::Read);
+                read.opcode = IORING_OP_READ;
+                read.flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+                read.fd = static_cast<int>(slot);
+                read.addr = reinterpret_cast<uint64_t>(results[index].data.data());
+                read.len = static_cast<unsigned int>(readSizes[slot]);
+
+                io_uring_sqe& close = queue(index, Operation::Close);
+                close.opcode = IORING_OP_CLOSE;
+                close.file_index = slot + 1;
+            };
+
+            auto onCompletion = [&](const io_uring_cqe& cqe)
+            {
+                const size_t index = static_cast<size_t>(cqe.user_data >> 2);
+                const Operation operation = static_cast<Operation>(cqe.user_data & 3);
+                const size_t slot = index - first;
+                Result& result = results[index];
+                operationsInFlight--;
+
+                switch (operation)
+                {
+                case Operation::Stat:
+                {
+                    if (cqe.res < 0)
+                    {
+                        result.error = -cqe.res;
+                        break;
+                    }
+
+                    const struct statx& stat = stats[slot];
+                    if (S_ISREG(stat.stx_mode) == false || stat.stx_size == 0 || stat.stx_size >= MaxChainedRead)
+                    {
+                        readSync.push_back(index);
+                        break;
+                    }
+
+                    // A spare byte tells a file of the stated size from one that grew since.
+                    readSizes[slot] = static_cast<size_t>(stat.stx_size) + 1;
+                    result.data.Resize(readSizes[slot]);
+                    queueChain(index);
+                    break;
+                }
+
+                case Operation::Open:
+                    if (cqe.res < 0)
+                    {
+                        result.error = -cqe.res;
+                        result.data.Resize(0);
+                    }
+                    break;
+
+                case Operation::Read:
+                    // Canceled when the open failed, already reported.
+                    if (cqe.res == -ECANCELED)
+                        break;
+
+                    if (cqe.res < 0)
+                    {
+                        result.error = -cqe.res;
+                        result.data.Resize(0);
+                    }
+                    else if (static_cast<size_t>(cqe.res) == readSizes[slot])
+                    {
+                        result.data.Resize(0);
+                        readSync.push_back(index);
+                    }
+                    else
+                    {
+                        result.data.Resize(static_cast<size_t>(cqe.res));
+                    }
+                    break;
+
+                case Operation::Close:
+                    break;
+                }
+            };
+
+            for (; first < filePaths.size(); first += batchSize)
+            {
+                const size_t count = (std::min)(batchSize, filePaths.size() - first);
+                for (size_t index = first; index < first + count; index++)
+                {
+                    io_uring_sqe& stat = queue(index, Operation::Stat);
+                    stat.opcode = IORING_OP_STATX;
+                    stat.fd = AT_FDCWD;
+                    stat.addr = reinterpret_cast<uint64_t>(filePaths[index].c_str());
+                    stat.len = STATX_TYPE | STATX_SIZE;
+                    stat.off = reinterpret_cast<uint64_t>(&stats[index - first]);
+                }
+
+                // The stat completions queue the chains, the next wait submits them, the slots are free once all completed.
+                while (operationsInFlight > 0)
+                {
+                    ring.SubmitAndWait(operationsInFlight);
+                    ring.ForEachCompletion(onCompletion);
+                }
+            }
+
+            for (size_t index : readSync)
+                ReadFileSync(filePaths[index], results[index]);
+        }
+
+        std::unique_ptr<IORing> fRing;
+#endif
+        unsigned int fThreads;
+    };
+}
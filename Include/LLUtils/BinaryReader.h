@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Endian.h>
+#include <LLUtils/FileMapping.h>
+
+namespace LLUtils
+{
+    // Zero-copy binary deserializer over a byte span.
+    // Every Read* call is bounds checked, for tight loops call Require() once and use the *Unchecked variants.
+    class BinaryReader
+    {
+    public:
+        BinaryReader(std::span<const std::byte> data) : fData(data)
+        {
+
+        }
+
+        BinaryReader(const std::byte* data, size_t size) : fData(data, size)
+        {
+
+        }
+
+        template <typename Alloc, size_t InlineBytes>
+        BinaryReader(const BufferBase<Alloc, InlineBytes>& buffer) : fData(buffer.data(), buffer.size())
+        {
+
+        }
+
+        // The mapping must outlive the reader.
+        BinaryReader(const FileMapping& mapping) : fData(static_cast<const std::byte*>(mapping.GetBuffer()), static_cast<size_t>(mapping.GetSize()))
+        {
+
+        }
+
+        size_t GetPosition() const
+        {
+            return fPosition;
+        }
+
+        size_t size() const
+        {
+            return fData.size();
+        }
+
+        size_t GetRemaining() const
+        {
+            return fData.size() - fPosition;
+        }
+
+        bool IsEnd() const
+        {
+            return fPosition == fData.size();
+        }
+
+        void Seek(size_t position)
+        {
+            if (position > fData.size())
+                throw std::runtime_error("Memory read overflow");
+            fPosition = position;
+        }
+
+        void Skip(size_t bytes)
+        {
+            Require(bytes);
+            fPosition += bytes;
+        }
+
+        // Throws unless at least 'bytes' bytes remain.
+        void Require(size_t bytes) const
+        {
+            if (bytes > fData.size() - fPosition)
+                throw std::runtime_error("Memory read overflow");
+        }
+
+        template <typename T, std::endian Order = std::endian::little>
+        T Read()
+        {
+            Require(sizeof(T));
+            return ReadUnchecked<T, Order>();
+        }
+
+        template <typename T>
+        T ReadLE()
+        {
+            return Read<T, std::endian::little>();
+        }
+
+        template <typename T>
+        T ReadBE()
+        {
+            return Read<T, std::endian::big>();
+        }
+
+        template <typename T, std::endian Order = std::endian::little>
+        T ReadUnchecked()
+        {
+            const T value = Endian::Load<T, Order>(fData.data() + fPosition);
+            fPosition += sizeof(T);
+            return value;
+        }
+
+        // Unsigned LEB128.
+        uint64_t ReadVarUInt()
+        {
+            uint64_t result = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                Require(1);
+                const uint8_t byte = static_cast<uint8_t>(fData[fPosition++]);
+                result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return result;
+            }
+            throw std::runtime_error("Malformed varint");
+        }
+
+        // Signed LEB128.
+        int64_t ReadVarInt()
+        {
+            uint64_t result = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                Require(1);
+                const uint8_t byte = static_cast<uint8_t>(fData[fPosition++]);
+                result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    if (shift + 7 < 64 && (byte & 0x40) != 0)
+                        result |= ~uint64_t{ 0 } << (shift + 7);
+                    return static_cast<int64_t>(result);
+                }
+            }
+            throw std::runtime_error("Malformed varint");
+        }
+
+        // Varint length prefixed string, the view points into the underlying data.
+        std::string_view ReadStringView()
+        {
+            const size_t length = ReadLength();
+            std::string_view view(reinterpret_cast<const char*>(fData.data() + fPosition), length);
+            fPosition += length;
+            return view;
+        }
+
+        std::string ReadString()
+        {
+            return std::string(ReadStringView());
+        }
+
+        std::span<const std::byte> ReadBytes(size_t size)
+        {
+            Require(size);
+            std::span<const std::byte> bytes = fData.subspan(fPosition, size);
+            fPosition += size;
+            return bytes;
+        }
+
+        // Bulk read of count elements, byte swapped to native order if needed.
+        template <typename T, std::endian Order = std::endian::little>
+        void ReadArray(std::span<T> dest)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            if (dest.size() > GetRemaining() / sizeof(T))
+                throw std::runtime_error("Memory read overflow");
+
+            memcpy(dest.data(), fData.data() + fPosition, dest.size_bytes());
+            fPosition += dest.size_bytes();
+            if constexpr (Order != std::endian::native && sizeof(T) > 1)
+            {
+                for (T& element : dest)
+                    element = Endian::ByteSwap(element);
+            }
+        }
+
+        // Zero-copy view of count native order elements, throws if the data is misaligned for T.
+        template <typename T>
+        std::span<const T> ReadArrayView(size_t count)
+        {
+            if (count > GetRemaining() / sizeof(T))
+                throw std::runtime_error("Memory read overflow");
+
+            std::span<const T> view = ReinterpretSpan<const T>(fData.data() + fPosition, count * sizeof(T));
+            fPosition += count * sizeof(T);
+            return view;
+        }
+
+    private:
+        size_t ReadLength()
+        {
+            const uint64_t length = ReadVarUInt();
+            if (length > GetRemaining())
+                throw std::runtime_error("Memory read overflow");
+            return static_cast<size_t>(length);
+        }
+
+        std::span<const std::byte> fData;
+        size_t fPosition = 0;
+    };
+}
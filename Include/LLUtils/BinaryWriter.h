@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Endian.h>
+
+namespace LLUtils
+{
+    // Binary serializer writing either into a growable buffer or into a fixed span.
+    // A growable buffer is over-allocated while writing, its size is set to the furthest byte written on Flush() or destruction.
+    // Every Write* call is bounds checked, for tight loops call Require() once and use the *Unchecked variants.
+    template <typename BufferType = Buffer>
+    class BinaryWriterBase
+    {
+    public:
+        // Grows the buffer as needed, writing starts at the end of its current contents.
+        BinaryWriterBase(BufferType& buffer) : fBuffer(&buffer), fData(buffer.data(), buffer.size()), fPosition(buffer.size()), fExtent(buffer.size())
+        {
+
+        }
+
+        // Fixed destination, writing past its end throws.
+        BinaryWriterBase(std::span<std::byte> data) : fData(data)
+        {
+
+        }
+
+        BinaryWriterBase(const BinaryWriterBase&) = delete;
+        BinaryWriterBase& operator=(const BinaryWriterBase&) = delete;
+
+        ~BinaryWriterBase()
+        {
+            Flush();
+        }
+
+        // Trim a growable buffer to the written extent.
+        void Flush()
+        {
+            if (fBuffer != nullptr)
+            {
+                fBuffer->Resize(GetExtent());
+                fData = std::span<std::byte>(fBuffer->data(), fBuffer->size());
+            }
+        }
+
+        size_t GetPosition() const
+        {
+            return fPosition;
+        }
+
+        // Furthest byte written so far.
+        size_t GetExtent() const
+        {
+            return (std::max)(fExtent, fPosition);
+        }
+
+        void Seek(size_t position)
+        {
+            fExtent = GetExtent();
+            if (position > (fBuffer != nullptr ? fExtent : fData.size()))
+                throw std::runtime_error("Memory write overflow");
+            fPosition = position;
+        }
+
+        // Make sure at least 'bytes' bytes can be written at the current position.
+        void Require(size_t bytes)
+        {
+            if (bytes > fData.size() - fPosition)
+                Grow(bytes);
+        }
+
+        template <typename T, std::endian Order = std::endian::little>
+        void Write(T value)
+        {
+            Require(sizeof(T));
+            WriteUnchecked<T, Order>(value);
+        }
+
+        template <typename T>
+        void WriteLE(T value)
+        {
+            Write<T, std::endian::little>(value);
+        }
+
+        template <typename T>
+        void WriteBE(T value)
+        {
+            Write<T, std::endian::big>(value);
+        }
+
+        template <typename T, std::endian Order = std::endian::little>
+        void WriteUnchecked(T value)
+        {
+            Endian::Store<T, Order>(fData.data() + fPosition, value);
+            fPosition += sizeof(T);
+        }
+
+        // Unsigned LEB128.
+        void WriteVarUInt(uint64_t value)
+        {
+            Require(GetVarUIntSize(value));
+            do
+            {
+                uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+                value >>= 7;
+                if (value != 0)
+                    byte |= 0x80;
+                fData[fPosition++] = static_cast<std::byte>(byte);
+            } while (value != 0);
+        }
+
+        // Signed LEB128.
+        void WriteVarInt(int64_t value)
+        {
+            Require(GetVarIntSize(value));
+            bool more = true;
+            while (more)
+            {
+                uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+                value >>= 7;
+                more = !((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0));
+                if (more)
+                    byte |= 0x80;
+                fData[fPosition++] = static_cast<std::byte>(byte);
+            }
+        }
+
+        // Varint length prefixed string.
+        void WriteString(std::string_view str)
+        {
+            WriteVarUInt(str.size());
+            WriteBytes(reinterpret_cast<const std::byte*>(str.data()), str.size());
+        }
+
+        void WriteBytes(const std::byte* data, size_t size)
+        {
+            if (size == 0)
+                return;
+            Require(size);
+            memcpy(fData.data() + fPosition, data, size);
+            fPosition += size;
+        }
+
+        // Bulk write, byte swapped from native order if needed.
+        template <typename T, std::endian Order = std::endian::little>
+        void WriteArray(std::span<const T> elements)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            if constexpr (Order == std::endian::native || sizeof(T) == 1)
+            {
+                WriteBytes(reinterpret_cast<const std::byte*>(elements.data()), elements.size_bytes());
+            }
+            else
+            {
+                Require(elements.size_bytes());
+                for (const T& element : elements)
+                    WriteUnchecked<T, Order>(element);
+            }
+        }
+
+        // Encoded size of a LEB128 value, 7 significant bits per byte.
+        static constexpr size_t GetVarUIntSize(uint64_t value)
+        {
+            return (static_cast<size_t>(std::bit_width(value | 1)) + 6) / 7;
+        }
+
+        // Includes the sign bit.
+        static constexpr size_t GetVarIntSize(int64_t value)
+        {
+            const uint64_t magnitude = static_cast<uint64_t>(value < 0 ? ~value : value);
+            return (static_cast<size_t>(std::bit_width(magnitude)) + 1 + 6) / 7;
+        }
+
+    private:
+
+        void Grow(size_t bytes)
+        {
+            if (fBuffer == nullptr)
+                throw std::runtime_error("Memory write overflow");
+
+            // Use the whole capacity so growth stays geometric, Flush trims the excess.
+            fBuffer->Resize(fPosition + bytes);
+            fBuffer->Resize(fBuffer->Capacity());
+            fData = std::span<std::byte>(fBuffer->data(), fBuffer->size());
+        }
+
+        BufferType* fBuffer = nullptr;
+        std::span<std::byte> fData;
+        size_t fPosition = 0;
+        size_t fExtent = 0;
+    };
+
+    using BinaryWriter = BinaryWriterBase<Buffer>;
+}
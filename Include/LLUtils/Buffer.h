@@ -21,10 +21,14 @@ SOFTWARE.
 */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <cstring>
+#include <concepts>
 #include <span>
 #include <LLUtils/Platform.h>
 #include <LLUtils/Utility.h>
@@ -52,10 +56,12 @@ namespace LLUtils
     };
 
 
-    class AlignedAlloc
+    template <size_t AlignmentBytes>
+    class AlignedAllocBase
     {
     public:
-        static constexpr int Alignment = 16;
+        static_assert(std::has_single_bit(AlignmentBytes), "Alignment must be a power of two");
+        static constexpr int Alignment = static_cast<int>(AlignmentBytes);
 
         static std::byte* Allocate(size_t size)
         {
@@ -81,6 +87,83 @@ namespace LLUtils
             std::free(buffer);
 #endif
         }
+
+        // Grows or shrinks the buffer, in place when the CRT allows it (e.g. mremap for large glibc chunks).
+        static std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+#if(LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32)
+            (void)oldSize;
+            return reinterpret_cast<std::byte*>(_aligned_realloc(buffer, LLUtils::Utility::Align<size_t>(newSize, Alignment), Alignment));
+#else
+            std::byte* reallocated = reinterpret_cast<std::byte*>(std::realloc(buffer, LLUtils::Utility::Align<size_t>(newSize, Alignment)));
+            if (reallocated == nullptr || reinterpret_cast<std::uintptr_t>(reallocated) % Alignment == 0)
+                return reallocated;
+
+            // realloc only guarantees fundamental alignment, fall back to a fresh aligned block.
+            // The original block is already gone, so if that fails keep the under-aligned one rather than losing the data.
+            std::byte* aligned = Allocate(newSize);
+            if (aligned == nullptr)
+                return reallocated;
+
+            memcpy(aligned, reallocated, (std::min)(oldSize, newSize));
+            std::free(reallocated);
+            return aligned;
+#endif
+        }
+    };
+
+    using AlignedAlloc = AlignedAllocBase<16>;
+    // Page aligned allocations, suitable for unbuffered (O_DIRECT) I/O.
+    using PageAlignedAlloc = AlignedAllocBase<4096>;
+
+    // Allocators may optionally provide Reallocate to let BufferBase grow in place.
+    template <typename Alloc>
+    concept ReallocatingAllocator = requires(std::byte* buffer, size_t size)
+    {
+        { Alloc::Reallocate(buffer, size, size) } -> std::same_as<std::byte*>;
+    };
+
+    // Guaranteed alignment of an allocator, Alloc::Alignment when declared otherwise the fundamental alignment.
+    template <typename Alloc>
+    constexpr size_t GetAllocatorAlignment()
+    {
+        if constexpr (requires { Alloc::Alignment; })
+            return static_cast<size_t>(Alloc::Alignment);
+        else
+            return alignof(std::max_align_t);
+    }
+
+    // Copy used by BufferBase::Read, Write and Clone.
+    // Large copies go through a replaceable function, memcpy by default, MemoryCopy.h installs its streaming / parallel copy.
+    class BufferCopy
+    {
+    public:
+        using CopyFunction = void (*)(void* dest, const void* src, size_t size);
+
+        // Smaller copies always use memcpy.
+        static constexpr size_t LargeCopyBytes = 64 * 1024;
+
+        static void Copy(void* dest, const void* src, size_t size)
+        {
+            if (size < LargeCopyBytes)
+                memcpy(dest, src, size);
+            else
+                sLargeCopy.load(std::memory_order_relaxed)(dest, src, size);
+        }
+
+        // nullptr restores memcpy.
+        static void SetLargeCopy(CopyFunction copy)
+        {
+            sLargeCopy.store(copy != nullptr ? copy : &CopyMemory, std::memory_order_relaxed);
+        }
+
+    private:
+        static void CopyMemory(void* dest, const void* src, size_t size)
+        {
+            memcpy(dest, src, size);
+        }
+
+        static inline std::atomic<CopyFunction> sLargeCopy{ &CopyMemory };
     };
 
 
@@ -91,11 +174,48 @@ namespace LLUtils
 #endif
 
 
-    template <typename Alloc>
+    // View raw bytes as a span of T, throws if the data is misaligned or the size is not a multiple of sizeof(T).
+    template <typename T, typename ByteType>
+    std::span<T> ReinterpretSpan(ByteType* data, size_t size)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        static_assert(std::is_const_v<T> || std::is_const_v<ByteType> == false, "Cannot drop constness");
+
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) 
+            throw std::runtime_error("RawBuffer: data is not properly aligned for type T");
+
+        if (size % sizeof(T) != 0) 
+            throw std::runtime_error("RawBuffer: buffer size is not a multiple of sizeof(T)");
+
+        LLUTILS_DISABLE_WARNING_PUSH
+        LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+        return std::span<T>(reinterpret_cast<T*>(data), size / sizeof(T));
+        LLUTILS_DISABLE_WARNING_POP
+    }
+
+
+    // Inline storage for small-buffer optimization, empty when InlineBytes is 0.
+    template <size_t InlineBytes>
+    struct BufferInlineStorage
+    {
+        std::byte* data() { return fData; }
+        alignas(AlignedAlloc::Alignment) std::byte fData[InlineBytes];
+    };
+
+    template <>
+    struct BufferInlineStorage<0>
+    {
+        std::byte* data() { return nullptr; }
+    };
+
+
+    // InlineBytes - payloads up to this size are kept inside the object and never reach the allocator.
+    template <typename Alloc, size_t InlineBytes = 0>
     class BufferBase
     {
     public:
         using Allocator = Alloc;
+        static constexpr size_t InlineCapacity = InlineBytes;
 
         BufferBase() {}
         BufferBase(size_t size)
@@ -202,7 +322,7 @@ namespace LLUtils
         void Read(std::byte* dest, size_t offset, size_t size) const
         {
             if (offset + size <= fSize)
-                memcpy(dest, fData + offset, size);
+                BufferCopy::Copy(dest, fData + offset, size);
             else
                 throw std::runtime_error("Memory read overflow");
         }
@@ -212,7 +332,7 @@ namespace LLUtils
             LLUTILS_DISABLE_WARNING_PUSH
                 LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
                 if (offset + size <= fSize)
-                    memcpy(fData + offset, BufferBase, size);
+                    BufferCopy::Copy(fData + offset, BufferBase, size);
                 else
                     throw std::runtime_error("Memory write overflow");
             LLUTILS_DISABLE_WARNING_POP
@@ -233,92 +353,184 @@ namespace LLUtils
             return fSize;
         }
 
+        size_t Capacity() const
+        {
+            return fCapacity;
+        }
 
-
-
-       template<typename T>
-        explicit operator std::span<const T>() const
+        // Ensure room for at least 'capacity' bytes, preserving the current contents.
+        void Reserve(size_t capacity)
         {
-            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            if (capacity > fCapacity)
+                ReallocateImp(capacity);
+        }
 
-            if (reinterpret_cast<std::uintptr_t>(data()) % alignof(T) != 0) 
-                throw std::runtime_error("RawBuffer: data is not properly aligned for type T");
+        // Change the size of the buffer, preserving contents up to the new size.
+        // Growing beyond the capacity grows geometrically so repeated calls are amortized O(1).
+        void Resize(size_t size)
+        {
+            if (size > fCapacity)
+                ReallocateImp((std::max)(size, fCapacity + fCapacity / 2));
+            fSize = size;
+        }
 
-            if (size() % sizeof(T) != 0) 
-                throw std::runtime_error("RawBuffer: data is not properly aligned for type T");
+        void Append(const std::byte* data, size_t size)
+        {
+            if (size == 0)
+                return;
 
             LLUTILS_DISABLE_WARNING_PUSH
             LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
-            return std::span<const T>(reinterpret_cast<const T*>(data()), size() / sizeof(T));
+            // Source may alias the current payload, which can move on reallocation.
+            const bool aliased = data >= fData && data < fData + fSize;
+            const size_t aliasOffset = aliased ? static_cast<size_t>(data - fData) : 0;
+            const size_t offset = fSize;
+            Resize(fSize + size);
+            memcpy(fData + offset, aliased ? fData + aliasOffset : data, size);
             LLUTILS_DISABLE_WARNING_POP
         }
 
-        template<typename T>
-        explicit operator std::span<T>() 
-        {
-            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
 
-            if (reinterpret_cast<std::uintptr_t>(data()) % alignof(T) != 0) 
-                throw std::runtime_error("RawBuffer: data is not properly aligned for type T");
 
-            if (size() % sizeof(T) != 0) 
-                throw std::runtime_error("RawBuffer: buffer size is not a multiple of sizeof(T)");
 
-            LLUTILS_DISABLE_WARNING_PUSH
-            LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
-            return std::span<T>(reinterpret_cast<T*>(data()), size() / sizeof(T));
-            LLUTILS_DISABLE_WARNING_POP
+        template<typename T>
+        explicit operator std::span<const T>() const
+        {
+            return ReinterpretSpan<const T>(data(), size());
+        }
+
+        template<typename T>
+        explicit operator std::span<T>() 
+        {
+            return ReinterpretSpan<T>(data(), size());
         }
 
         // buffer must have been allocated with the corresponding Allocator.
         void TransferOwnership(size_t size, std::byte*& data)
         {
             fSize = size;
+            fCapacity = size;
             fData = data;
             data = nullptr;
         }
 
         // buffer must be freed  with the corresponding Allocator.
+        // Inline payloads are first moved to a buffer allocated with the corresponding Allocator.
         void RemoveOwnership(size_t& size, std::byte*& data)
         {
+            if (IsInline())
+            {
+                std::byte* heapData = Allocator::Allocate(fSize);
+                memcpy(heapData, fData, fSize);
+                fData = heapData;
+            }
+
             size = fSize;
             fSize = 0;
+            fCapacity = 0;
             data = fData;
             fData = nullptr;
         }
 
+        // Returns true if the payload is held in the object's inline storage.
+        bool IsInline() const
+        {
+            if constexpr (InlineBytes > 0)
+                return fData != nullptr && fData == fInline.fData;
+            else
+                return false;
+        }
+
     private:
         // private methods
         void Swap(BufferBase&& rhs)
         {
-            std::swap(fSize, rhs.fSize);
-            rhs.fSize = 0;
-            std::swap(fData, rhs.fData);
-            Allocator::Deallocate(rhs.fData);
+            FreeImpl();
+            if (rhs.IsInline())
+            {
+                fData = fInline.data();
+                memcpy(fData, rhs.fData, rhs.fSize);
+            }
+            else
+            {
+                fData = rhs.fData;
+            }
+            fSize = rhs.fSize;
+            fCapacity = rhs.fCapacity;
             rhs.fData = nullptr;
+            rhs.fSize = 0;
+            rhs.fCapacity = 0;
         }
 
         void AllocateImp(size_t size)
         {
             Free();
-            fData = Allocator::Allocate(size);
+            if (InlineBytes > 0 && size <= InlineBytes)
+            {
+                fData = fInline.data();
+                fCapacity = InlineBytes;
+            }
+            else
+            {
+                fData = Allocator::Allocate(size);
+                fCapacity = size;
+            }
             fSize = size;
         }
 
+        void ReallocateImp(size_t capacity)
+        {
+            if (fData == nullptr)
+            {
+                AllocateImp(capacity);
+                fSize = 0;
+                return;
+            }
+
+            std::byte* newData = nullptr;
+            if (IsInline() || ReallocatingAllocator<Allocator> == false)
+            {
+                newData = Allocator::Allocate(capacity);
+                if (newData == nullptr)
+                    throw std::bad_alloc();
+
+                memcpy(newData, fData, fSize);
+                if (IsInline() == false)
+                    Allocator::Deallocate(fData);
+            }
+            else
+            {
+                // On failure the allocator leaves the original block untouched.
+                if constexpr (ReallocatingAllocator<Allocator>)
+                    newData = Allocator::Reallocate(fData, fCapacity, capacity);
+
+                if (newData == nullptr)
+                    throw std::bad_alloc();
+            }
+
+            fData = newData;
+            fCapacity = capacity;
+        }
+
 
 
         void FreeImpl()
         {
             if (fData != nullptr)
             {
-                Allocator::Deallocate(fData);
+                if (IsInline() == false)
+                    Allocator::Deallocate(fData);
                 fData = nullptr;
                 fSize = 0;
+                fCapacity = 0;
             }
         }
         // private member fields
         std::byte* fData = nullptr;
         size_t fSize = 0;
+        size_t fCapacity = 0;
+        LLUTILS_NO_UNIQUE_ADDRESS BufferInlineStorage<InlineBytes> fInline;
     };
     using Buffer = BufferBase<DefaultAllocator>;
+    using SmallBuffer = BufferBase<DefaultAllocator, 256>;
 }
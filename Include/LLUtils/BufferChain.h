@@ -0,0 +1,194 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <LLUtils/Buffer.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <climits>
+    #include <sys/uio.h>
+#endif
+
+namespace LLUtils
+{
+    // Ordered list of buffers treated as one logical byte sequence.
+    // Appending moves the buffer in, no payload is ever copied until Read or Flatten is called.
+    template <typename BufferType = Buffer>
+    class BufferChainBase
+    {
+    public:
+        using const_iterator = typename std::vector<BufferType>::const_iterator;
+
+        struct Location
+        {
+            size_t segment;
+            size_t offset;
+        };
+
+        void Append(BufferType&& buffer)
+        {
+            if (buffer.size() == 0)
+                return;
+
+            fOffsets.push_back(fSize);
+            fSize += buffer.size();
+            fSegments.push_back(std::move(buffer));
+        }
+
+        void Clear()
+        {
+            fSegments.clear();
+            fOffsets.clear();
+            fSize = 0;
+        }
+
+        size_t size() const
+        {
+            return fSize;
+        }
+
+        size_t GetSegmentCount() const
+        {
+            return fSegments.size();
+        }
+
+        const BufferType& GetSegment(size_t index) const
+        {
+            return fSegments.at(index);
+        }
+
+        // Logical offset of the first byte of a segment.
+        size_t GetSegmentOffset(size_t index) const
+        {
+            return fOffsets.at(index);
+        }
+
+        const_iterator begin() const
+        {
+            return fSegments.begin();
+        }
+
+        const_iterator end() const
+        {
+            return fSegments.end();
+        }
+
+        // Find the segment holding a logical offset, O(log segments).
+        Location Locate(size_t offset) const
+        {
+            if (offset >= fSize)
+                throw std::runtime_error("Offset out of range");
+
+            auto it = std::upper_bound(fOffsets.begin(), fOffsets.end(), offset);
+            const size_t segment = static_cast<size_t>(it - fOffsets.begin()) - 1;
+            return { segment, offset - fOffsets[segment] };
+        }
+
+        std::byte operator[](size_t offset) const
+        {
+            const Location location = Locate(offset);
+            return fSegments[location.segment].data()[location.offset];
+        }
+
+        void Read(std::byte* dest, size_t offset, size_t size) const
+        {
+            if (offset > fSize || size > fSize - offset)
+                throw std::runtime_error("Memory read overflow");
+
+            if (size == 0)
+                return;
+
+            Location location = Locate(offset);
+            while (size > 0)
+            {
+                const BufferType& segment = fSegments[location.segment];
+                const size_t length = (std::min)(size, segment.size() - location.offset);
+                segment.Read(dest, location.offset, length);
+                dest += length;
+                size -= length;
+                location = { location.segment + 1, 0 };
+            }
+        }
+
+        // Copy the whole chain into one contiguous buffer.
+        BufferType Flatten() const
+        {
+            BufferType flat(fSize);
+            Read(flat.data(), 0, fSize);
+            return flat;
+        }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        // I/O vector over all segments, suitable for writev. Callers must respect IOV_MAX per call.
+        std::vector<iovec> ToIOVec() const
+        {
+            std::vector<iovec> vec;
+            vec.reserve(fSegments.size());
+            for (const BufferType& segment : fSegments)
+                vec.push_back({ const_cast<std::byte*>(segment.data()), segment.size() });
+            return vec;
+        }
+
+        // Write the entire chain to a file descriptor with writev, handling partial writes and IOV_MAX.
+        void WriteTo(int fd) const
+        {
+            std::vector<iovec> vec = ToIOVec();
+            size_t first = 0;
+            while (first < vec.size())
+            {
+                const int count = static_cast<int>(std::min<size_t>(vec.size() - first, IOV_MAX));
+                const ssize_t written = writev(fd, vec.data() + first, count);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error("Cannot write to file");
+                }
+
+                size_t remaining = static_cast<size_t>(written);
+                while (first < vec.size() && remaining >= vec[first].iov_len)
+                    remaining -= vec[first++].iov_len;
+
+                if (remaining > 0)
+                {
+                    vec[first].iov_base = static_cast<std::byte*>(vec[first].iov_base) + remaining;
+                    vec[first].iov_len -= remaining;
+                }
+            }
+        }
+#endif
+
+    private:
+        std::vector<BufferType> fSegments;
+        std::vector<size_t> fOffsets;
+        size_t fSize = 0;
+    };
+
+    using BufferChain = BufferChainBase<Buffer>;
+}
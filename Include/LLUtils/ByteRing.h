@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <LLUtils/Platform.h>
+#include <LLUtils/Utility.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace LLUtils
+{
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    // Lock-free single producer / single consumer byte ring.
+    // The ring memory is mapped twice back to back, so any readable or writable region is contiguous
+    // even when it wraps around the end of the ring.
+    class ByteRing
+    {
+    public:
+        // capacity is rounded up to a multiple of the page size.
+        explicit ByteRing(size_t capacity)
+        {
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            fCapacity = LLUtils::Utility::Align<size_t>(std::max<size_t>(capacity, 1), pageSize);
+
+            const int fd = memfd_create("LLUtils::ByteRing", MFD_CLOEXEC);
+            if (fd == -1)
+                throw std::runtime_error("Cannot create ring buffer memory");
+
+            if (ftruncate(fd, static_cast<off_t>(fCapacity)) == -1)
+            {
+                close(fd);
+                throw std::runtime_error("Cannot size ring buffer memory");
+            }
+
+            // Reserve twice the address range, then map the same pages over both halves.
+            void* base = mmap(nullptr, fCapacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                close(fd);
+                throw std::runtime_error("Cannot reserve ring buffer address space");
+            }
+
+            fData = static_cast<std::byte*>(base);
+            const bool mapped = mmap(fData, fCapacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+                && mmap(fData + fCapacity, fCapacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+            close(fd);
+
+            if (mapped == false)
+            {
+                munmap(fData, fCapacity * 2);
+                throw std::runtime_error("Cannot map ring buffer memory");
+            }
+        }
+
+        ByteRing(const ByteRing&) = delete;
+        ByteRing& operator=(const ByteRing&) = delete;
+
+        ~ByteRing()
+        {
+            munmap(fData, fCapacity * 2);
+        }
+
+        size_t Capacity() const
+        {
+            return fCapacity;
+        }
+
+        // Approximate when called concurrently.
+        size_t size() const
+        {
+            return fHead.load(std::memory_order_acquire) - fTail.load(std::memory_order_acquire);
+        }
+
+        // Producer side
+        // Contiguous free space, valid until the next CommitWrite.
+        // The consumer's position is re-read only when less than 'wanted' bytes are known to be free.
+        std::span<std::byte> GetWriteRegion(size_t wanted = 1)
+        {
+            const size_t head = fHead.load(std::memory_order_relaxed);
+            if (fCapacity - (head - fCachedTail) < wanted)
+                fCachedTail = fTail.load(std::memory_order_acquire);
+
+            return std::span<std::byte>(fData + head % fCapacity, fCapacity - (head - fCachedTail));
+        }
+
+        // Publish 'size' bytes written into the write region.
+        void CommitWrite(size_t size)
+        {
+            fHead.store(fHead.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+        // Copy as much as fits, returns the number of bytes written.
+        size_t Write(const std::byte* data, size_t size)
+        {
+            std::span<std::byte> region = GetWriteRegion(size);
+
+            const size_t length = (std::min)(size, region.size());
+            memcpy(region.data(), data, length);
+            CommitWrite(length);
+            return length;
+        }
+
+        // Consumer side
+        // Contiguous readable bytes, valid until the next CommitRead.
+        // The producer's position is re-read only when less than 'wanted' bytes are known to be available.
+        std::span<const std::byte> GetReadRegion(size_t wanted = 1)
+        {
+            const size_t tail = fTail.load(std::memory_order_relaxed);
+            if (fCachedHead - tail < wanted)
+                fCachedHead = fHead.load(std::memory_order_acquire);
+
+            return std::span<const std::byte>(fData + tail % fCapacity, fCachedHead - tail);
+        }
+
+        // Release 'size' bytes of the read region back to the producer.
+        void CommitRead(size_t size)
+        {
+            fTail.store(fTail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+        // Copy up to 'size' bytes out, returns the number of bytes read.
+        size_t Read(std::byte* dest, size_t size)
+        {
+            std::span<const std::byte> region = GetReadRegion(size);
+
+            const size_t length = (std::min)(size, region.size());
+            memcpy(dest, region.data(), length);
+            CommitRead(length);
+            return length;
+        }
+
+    private:
+        // Head and tail are monotonic byte counters, each written by one side only.
+        // Each side keeps a cached copy of the other's counter to avoid touching the shared line on every call.
+        alignas(64) std::atomic<size_t> fHead{ 0 };
+        size_t fCachedTail = 0;
+        alignas(64) std::atomic<size_t> fTail{ 0 };
+        size_t fCachedHead = 0;
+        alignas(64) std::byte* fData = nullptr;
+        size_t fCapacity = 0;
+    };
+#endif
+}
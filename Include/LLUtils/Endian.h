@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <LLUtils/Platform.h>
+
+namespace LLUtils
+{
+    class Endian
+    {
+    public:
+        static constexpr bool IsLittleEndian = std::endian::native == std::endian::little;
+
+        template <typename T>
+        static T ByteSwap(T value)
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "ByteSwap requires an arithmetic or enum type");
+            static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "ByteSwap supports 1, 2, 4 and 8 byte types");
+
+            if constexpr (sizeof(T) == 1)
+            {
+                return value;
+            }
+            else
+            {
+                using Unsigned = UnsignedOfSize<sizeof(T)>;
+                Unsigned raw;
+                memcpy(&raw, &value, sizeof(T));
+                raw = ByteSwapUnsigned(raw);
+                memcpy(&value, &raw, sizeof(T));
+                return value;
+            }
+        }
+
+        // Convert between native and the given byte order, a no-op when they match.
+        template <std::endian Order, typename T>
+        static T Convert(T value)
+        {
+            if constexpr (Order == std::endian::native)
+                return value;
+            else
+                return ByteSwap(value);
+        }
+
+        // Load / store a value of the given byte order from possibly unaligned memory.
+        template <typename T, std::endian Order = std::endian::little>
+        static T Load(const void* source)
+        {
+            T value;
+            memcpy(&value, source, sizeof(T));
+            return Convert<Order>(value);
+        }
+
+        template <typename T, std::endian Order = std::endian::little>
+        static void Store(void* dest, T value)
+        {
+            value = Convert<Order>(value);
+            memcpy(dest, &value, sizeof(T));
+        }
+
+    private:
+        template <size_t Size>
+        using UnsignedOfSize = std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>;
+
+        static uint16_t ByteSwapUnsigned(uint16_t value)
+        {
+#if LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC
+            return _byteswap_ushort(value);
+#else
+            return __builtin_bswap16(value);
+#endif
+        }
+
+        static uint32_t ByteSwapUnsigned(uint32_t value)
+        {
+#if LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC
+            return _byteswap_ulong(value);
+#else
+            return __builtin_bswap32(value);
+#endif
+        }
+
+        static uint64_t ByteSwapUnsigned(uint64_t value)
+        {
+#if LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC
+            return _byteswap_uint64(value);
+#else
+            return __builtin_bswap64(value);
+#endif
+        }
+    };
+}
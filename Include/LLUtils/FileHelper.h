@@ -20,22 +20,58 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "Buffer.h"
+#include "FileMapping.h"
 #include "FileSystemHelper.h"
+#include "LineReader.h"
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+    #include <Windows.h>
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 namespace LLUtils
 {
     class File
     {
     public:
+        // Returns an empty string if the file can't be opened.
+        // On Windows CRLF line endings are converted to LF, as text mode streams do.
         template <typename string_type = native_string_type, typename char_type = typename string_type::value_type>
         static string_type ReadAllText(native_string_type filePath)
         {
             using namespace std;
+            if constexpr (sizeof(char_type) == 1)
+            {
+                // Read the bytes straight into the string.
+                NativeFile file(filePath);
+                if (file.IsOpen() == false)
+                    return string_type{};
+
+                string_type text;
+                ReadToEnd(file, text);
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                size_t length = 0;
+                for (size_t i = 0; i < text.size(); i++)
+                    if (text[i] != '\r' || i + 1 == text.size() || text[i + 1] != '\n')
+                        text[length++] = text[i];
+                text.resize(length);
+#endif
+                return text;
+            }
+
             basic_ifstream<char_type, char_traits<char_type>> t(filePath.c_str());
             if (t.is_open())
             {
@@ -47,6 +83,60 @@ namespace LLUtils
                 return string_type{};
         }
 
+        // Invoke 'func(std::string_view line)' for each line of the file without copying the lines, see LineReader.
+        // Return false from 'func' to stop early. Regular files are mapped, other files (pipes, procfs) are read in chunks.
+        template <typename Func>
+        static void ForEachLine(native_string_type filePath, Func&& func, size_t chunkSize = 1024 * 1024)
+        {
+            // Pipes and procfs files have no size to map, closing and reopening them would lose data, so they're
+            // told apart before opening and read in chunks instead.
+            std::error_code error;
+            if (std::filesystem::is_regular_file(filePath, error) && std::filesystem::file_size(filePath, error) > 0 && !error)
+            {
+                FileMapping mapping(filePath);
+                mapping.Advise(FileMapping::Advice::Sequential);
+                LineReader::ForEachLine(std::string_view(static_cast<const char*>(mapping.GetBuffer()), static_cast<size_t>(mapping.GetSize())), func);
+                return;
+            }
+
+            NativeFile file(filePath);
+            if (file.IsOpen() == false)
+                throw std::runtime_error("Cannot open file");
+
+            LLUtils::Buffer buf(std::max<size_t>(chunkSize, 1));
+            size_t filled = 0;
+            for (;;)
+            {
+                // Lines longer than the buffer grow it.
+                if (filled == buf.size())
+                    buf.Resize(buf.size() * 2);
+
+                LLUTILS_DISABLE_WARNING_PUSH
+                LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+                const size_t requested = buf.size() - filled;
+                const size_t bytesRead = file.Read(buf.data() + filled, requested);
+                filled += bytesRead;
+                const std::string_view text(reinterpret_cast<const char*>(buf.data()), filled);
+                if (bytesRead < requested)
+                {
+                    LineReader::ForEachLine(text, func);
+                    return;
+                }
+
+                // Only complete lines, the partial last line is moved to the start of the buffer.
+                const size_t lastNewLine = text.rfind('\n');
+                if (lastNewLine == std::string_view::npos)
+                    continue;
+
+                if (LineReader::ForEachLine(text.substr(0, lastNewLine + 1), func) == false)
+                    return;
+
+                filled -= lastNewLine + 1;
+                memmove(buf.data(), buf.data() + lastNewLine + 1, filled);
+                LLUTILS_DISABLE_WARNING_POP
+            }
+        }
+
 		template <class string_type = native_string_type, typename char_type = typename string_type::value_type>
 		static void WriteAllText(const string_type& filePath, const string_type& text, bool append = false)
 		{
@@ -58,11 +148,102 @@ namespace LLUtils
         template <class string_type = native_string_type>
         static LLUtils::Buffer ReadAllBytes(native_string_type filePath)
         {
-            using namespace std;
-			uintmax_t fileSize = filesystem::file_size(filePath);
-            LLUtils::Buffer buf(static_cast<size_t>(fileSize));
-            ifstream t(filesystem::path(filePath), std::ios::binary);
-            t.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(fileSize));
+            NativeFile file(filePath);
+            if (file.IsOpen() == false)
+                throw std::runtime_error("Cannot open file");
+
+            LLUtils::Buffer buf;
+            ReadToEnd(file, buf);
+            return buf;
+        }
+
+        // Read a large file with several threads, each reading 'chunkSize' bytes at a time at its own offset
+        // straight into the returned buffer. Saturates fast storage where a single sequential read can't.
+        // threads - 0 means the number of hardware threads.
+        // chunkSize - raised to at least 64 KB, smaller reads cost more in per call overhead than they gain in parallelism.
+        static LLUtils::Buffer ReadAllBytesParallel(native_string_type filePath, unsigned int threads = 0, size_t chunkSize = 8 * 1024 * 1024)
+        {
+            NativeFile file(filePath, NativeFile::Access::Concurrent);
+            if (file.IsOpen() == false)
+                throw std::runtime_error("Cannot open file");
+
+            LLUtils::Buffer buf;
+            const size_t fileSize = file.GetSize();
+            chunkSize = std::max<size_t>(chunkSize, 64 * 1024);
+            if (threads == 0)
+                threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+            const size_t chunkCount = (fileSize + chunkSize - 1) / chunkSize;
+            if (threads == 1 || chunkCount <= 1)
+            {
+                ReadToEnd(file, buf);
+                return buf;
+            }
+
+            // Each chunk is read sequentially, a larger read ahead window keeps more requests in flight per thread.
+            file.AdviseSequential();
+            buf.Resize(fileSize);
+
+            std::atomic<size_t> nextChunk = 0;
+            std::atomic<bool> failed = false;
+            auto worker = [&]
+            {
+                for (size_t chunk = nextChunk++; chunk < chunkCount && failed.load(std::memory_order_relaxed) == false; chunk = nextChunk++)
+                {
+                    const size_t offset = chunk * chunkSize;
+                    const size_t size = (std::min)(chunkSize, fileSize - offset);
+                    LLUTILS_DISABLE_WARNING_PUSH
+                    LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+                    if (file.ReadAt(buf.data() + offset, size, offset) != size)
+                        failed = true;
+                    LLUTILS_DISABLE_WARNING_POP
+                }
+            };
+
+            std::vector<std::thread> workers;
+            try
+            {
+                for (size_t i = 1; i < std::min<size_t>(threads, chunkCount); i++)
+                    workers.emplace_back(worker);
+            }
+            catch (...)
+            {
+                // Out of threads, the ones already started and this one read the remaining chunks.
+            }
+
+            worker();
+            for (std::thread& thread : workers)
+                thread.join();
+
+            if (failed)
+                throw std::runtime_error("Cannot read file");
+
+            return buf;
+        }
+
+        // Read bypassing the OS page cache (O_DIRECT / FILE_FLAG_NO_BUFFERING), for large files read once.
+        // Falls back to a cached read where the file system doesn't support unbuffered I/O.
+        static BufferBase<PageAlignedAlloc> ReadAllBytesDirect(native_string_type filePath)
+        {
+            NativeFile file(filePath, NativeFile::Access::Direct);
+            if (file.IsOpen() == false)
+            {
+                file = NativeFile(filePath);
+                if (file.IsOpen() == false)
+                    throw std::runtime_error("Cannot open file");
+            }
+
+            BufferBase<PageAlignedAlloc> buf;
+            if (file.IsDirect() == false)
+            {
+                ReadToEnd(file, buf);
+                return buf;
+            }
+
+            // Unbuffered reads must be done in whole blocks into aligned memory, the last read returns short at the end of the file.
+            const size_t fileSize = file.GetSize();
+            buf.Resize(LLUtils::Utility::Align<size_t>((std::max)(fileSize, size_t{ 1 }), PageAlignedAlloc::Alignment));
+            buf.Resize((std::min)(file.Read(buf.data(), buf.size()), fileSize));
             return buf;
         }
 
@@ -80,5 +261,252 @@ namespace LLUtils
             ofstream file(path, std::ios::binary | (append ? std::ios_base::app : std::ios_base::out));
             file.write(reinterpret_cast<const char*>(buffer),static_cast<std::streamsize>(size));
         }
+
+        // Minimal RAII wrapper over a native read-only file handle, also used by AsyncFileReader.
+        class NativeFile
+        {
+        public:
+            enum class Access
+            {
+                  Sequential
+                , Direct     // Bypass the page cache, O_DIRECT / FILE_FLAG_NO_BUFFERING.
+                , Concurrent // ReadAt from several threads, opened for overlapped I/O on Windows where synchronous handles serialize reads.
+            };
+
+            NativeFile(const native_string_type& filePath, Access access = Access::Sequential) : fAccess(access)
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                const DWORD accessFlags = access == Access::Direct ? FILE_FLAG_NO_BUFFERING : access == Access::Concurrent ? FILE_FLAG_OVERLAPPED : 0;
+                fHandle = CreateFile(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN | accessFlags, nullptr);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                fHandle = open(filePath.c_str(), O_RDONLY | O_CLOEXEC | (access == Access::Direct ? O_DIRECT : 0));
+#endif
+                if (IsOpen() == false)
+                    CaptureError();
+            }
+
+            NativeFile(const NativeFile&) = delete;
+
+            NativeFile& operator=(NativeFile&& rhs) noexcept
+            {
+                std::swap(fHandle, rhs.fHandle);
+                std::swap(fAccess, rhs.fAccess);
+                std::swap(fError, rhs.fError);
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                std::swap(fPosition, rhs.fPosition);
+#endif
+                return *this;
+            }
+
+            ~NativeFile()
+            {
+                if (IsOpen())
+                {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                    CloseHandle(fHandle);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                    close(fHandle);
+#endif
+                }
+            }
+
+            bool IsOpen() const
+            {
+                return fHandle != InvalidHandle;
+            }
+
+            // OS error code (errno, GetLastError on Windows) of the last failed call, 0 if none failed.
+            int GetError() const
+            {
+                return fError;
+            }
+
+            bool IsDirect() const
+            {
+                return fAccess == Access::Direct;
+            }
+
+            // Size of a regular file, 0 when unknown (e.g. pipes and procfs files).
+            size_t GetSize() const
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                LARGE_INTEGER size;
+                if (GetFileSizeEx(fHandle, &size) == 0)
+                {
+                    CaptureError();
+                    throw std::runtime_error("Cannot get file information");
+                }
+                return static_cast<size_t>(size.QuadPart);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                struct stat64 sb;
+                if (fstat64(fHandle, &sb) == -1)
+                {
+                    CaptureError();
+                    throw std::runtime_error("Cannot get file information");
+                }
+                return S_ISREG(sb.st_mode) ? static_cast<size_t>(sb.st_size) : 0;
+#endif
+            }
+
+            // Read at 'offset' without moving the file position, safe to call from several threads.
+            // Reads only run in parallel on Windows when the file was opened with Access::Concurrent.
+            // Returns the number of bytes read, less than 'size' only at the end of the file or on error.
+            size_t ReadAt(std::byte* data, size_t size, size_t offset) const
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                // Signaled when an overlapped read completes, one per call so concurrent reads don't wake each other.
+                const HANDLE event = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+                if (event == nullptr)
+                    return 0;
+#endif
+                size_t total = 0;
+                while (total < size)
+                {
+                    LLUTILS_DISABLE_WARNING_PUSH
+                    LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                    OVERLAPPED overlapped{};
+                    overlapped.Offset = static_cast<DWORD>((offset + total) & 0xFFFFFFFF);
+                    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset + total) >> 32);
+                    overlapped.hEvent = event;
+                    DWORD bytesRead = 0;
+                    const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - total, 1u << 30));
+                    if (ReadFile(fHandle, data + total, chunk, nullptr, &overlapped) == 0 && GetLastError() != ERROR_IO_PENDING && GetLastError() != ERROR_HANDLE_EOF)
+                    {
+                        CaptureError();
+                        break;
+                    }
+                    // The end of the file is reported as ERROR_HANDLE_EOF with no bytes read.
+                    if (GetOverlappedResult(fHandle, &overlapped, &bytesRead, TRUE) == 0 && GetLastError() != ERROR_HANDLE_EOF)
+                    {
+                        CaptureError();
+                        break;
+                    }
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                    const ssize_t bytesRead = pread64(fHandle, data + total, std::min<size_t>(size - total, 1u << 30), static_cast<off64_t>(offset + total));
+                    if (bytesRead == -1)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        CaptureError();
+                        break;
+                    }
+#endif
+                    LLUTILS_DISABLE_WARNING_POP
+                    if (bytesRead == 0)
+                        break;
+                    total += static_cast<size_t>(bytesRead);
+                }
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                CloseHandle(event);
+#endif
+                return total;
+            }
+
+            // Hint that the file is read sequentially, doubling the read ahead window.
+            void AdviseSequential() const
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                posix_fadvise64(fHandle, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            }
+
+            // Read until 'size' bytes are read or the end of the file is reached, returns the number of bytes read.
+            // Unbuffered reads stop at the first short read, it leaves the file position unaligned so a further read would fail.
+            size_t Read(std::byte* data, size_t size)
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                if (fAccess == Access::Concurrent)
+                {
+                    const size_t bytesRead = ReadAt(data, size, fPosition);
+                    fPosition += bytesRead;
+                    return bytesRead;
+                }
+#endif
+                size_t total = 0;
+                while (total < size)
+                {
+                    const size_t chunk = (std::min)(size - total, size_t{ 1 } << 30);
+                    LLUTILS_DISABLE_WARNING_PUSH
+                    LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                    DWORD bytesRead = 0;
+                    if (ReadFile(fHandle, data + total, static_cast<DWORD>(chunk), &bytesRead, nullptr) == 0)
+                    {
+                        CaptureError();
+                        throw std::runtime_error("Cannot read file");
+                    }
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                    const ssize_t bytesRead = read(fHandle, data + total, chunk);
+                    if (bytesRead == -1)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        CaptureError();
+                        throw std::runtime_error("Cannot read file");
+                    }
+#endif
+                    LLUTILS_DISABLE_WARNING_POP
+                    total += static_cast<size_t>(bytesRead);
+                    if (bytesRead == 0 || (IsDirect() && static_cast<size_t>(bytesRead) < chunk))
+                        break;
+                }
+                return total;
+            }
+
+        private:
+            void CaptureError() const
+            {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+                fError = static_cast<int>(GetLastError());
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+                fError = errno;
+#endif
+            }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            static inline const HANDLE InvalidHandle = INVALID_HANDLE_VALUE;
+            HANDLE fHandle;
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            static constexpr int InvalidHandle = -1;
+            int fHandle;
+#endif
+            Access fAccess;
+            mutable int fError = 0;
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            // Overlapped handles have no file position, Read keeps its own.
+            size_t fPosition = 0;
+#endif
+        };
+
+        // Read the rest of the file into a Buffer or a std::string with no intermediate copies.
+        // Sized from the file size up front, then grown for files that report no size or keep growing.
+        template <typename Container>
+        static void ReadToEnd(NativeFile& file, Container& container)
+        {
+            auto resize = [&container](size_t newSize)
+            {
+                if constexpr (requires { container.Resize(newSize); })
+                    container.Resize(newSize);
+                else
+                    container.resize(newSize);
+            };
+
+            constexpr size_t MinimumGrowth = 64 * 1024;
+            size_t size = file.GetSize();
+            // A spare byte tells a file of the exact size from one that grew since its size was queried.
+            resize(size + 1);
+            size = file.Read(reinterpret_cast<std::byte*>(container.data()), container.size());
+            while (size == container.size())
+            {
+                resize((std::max)(size * 2, size + MinimumGrowth));
+                LLUTILS_DISABLE_WARNING_PUSH
+                LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+                size += file.Read(reinterpret_cast<std::byte*>(container.data()) + size, container.size() - size);
+                LLUTILS_DISABLE_WARNING_POP
+            }
+            resize(size);
+        }
     };
 }
@@ -21,17 +21,28 @@ SOFTWARE.
 */
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 #include <cstdint>
 #include "Platform.h"
 #include "StringDefs.h"
+#include "EnumClassBitwise.h"
+#include "Warnings.h"
 
 #if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
     #include <Windows.h>
+    #include <Psapi.h>
 #elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
     #include <sys/mman.h>
+    #include <sys/resource.h>
 	#include <sys/stat.h>
+    #include <cerrno>
     #include <fcntl.h>
     #include <unistd.h>
 #endif
@@ -47,11 +58,60 @@ namespace LLUtils
     class FileMapping
     {
     public:
-        FileMapping(const native_string_type& filePath) : fFilePath(filePath)
+        enum class Mode
+        {
+              ReadOnly      // Existing file, private read-only view.
+            , ReadWrite     // Existing file, shared writable view.
+            , OpenOrCreate  // Create the file if missing, shared writable view.
+        };
+
+        enum class Options : uint32_t
+        {
+              None      = 0
+            , Populate  = 1 << 0 // Pre-fault the whole view when it is mapped (MAP_POPULATE).
+        };
+        LLUTILS_DEFINE_ENUM_CLASS_FLAG_OPERATIONS_IN_CLASS(Options)
+
+        // Expected access pattern, see Advise.
+        enum class Advice
+        {
+              Normal
+            , Sequential    // Aggressive read ahead, pages may be freed soon after access.
+            , Random        // No read ahead.
+            , WillNeed      // Start reading the range in the background.
+            , DontNeed      // Drop the range from memory, it will be faulted in again on access.
+            , HugePage      // Back the range with transparent huge pages where the file system supports it.
+        };
+
+        // Part of the file to map, see MapWindow.
+        struct Window
+        {
+            uintmax_t offset;
+            size_t length;
+        };
+
+        FileMapping(const native_string_type& filePath) : FileMapping(filePath, Mode::ReadOnly)
+        {
+
+        }
+
+        // In writable modes the file is extended to at least 'minimumSize' bytes.
+        FileMapping(const native_string_type& filePath, Mode mode, uintmax_t minimumSize = 0, Options options = Options::None)
+            : fFilePath(filePath), fMode(mode), fOptions(options), fMinimumSize(minimumSize)
         {
             Open();
         }
 
+        // Map only a window of the file, it can later be moved with MapWindow.
+        FileMapping(const native_string_type& filePath, Mode mode, Window window, Options options = Options::None)
+            : fFilePath(filePath), fMode(mode), fOptions(options), fWindowed(true), fWindowLength(window.length), fViewOffset(window.offset), fViewSize(window.length)
+        {
+            Open();
+        }
+
+        FileMapping(const FileMapping&) = delete;
+        FileMapping& operator=(const FileMapping&) = delete;
+
         ~FileMapping()
         {
             Close();
@@ -60,62 +120,421 @@ namespace LLUtils
         void Open()
         {
             Close();
-            OpenImp();
+            try
+            {
+                OpenImp();
+            }
+            catch (...)
+            {
+                Close();
+                throw;
+            }
         }
 
         void Close()
         {
+            Unmap();
 #if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
-            if (fView != nullptr && UnmapViewOfFile(fView) == 0)
-                throw std::runtime_error("Error unmapping file");
-
             if (fHandleMMF != nullptr && CloseHandle(fHandleMMF) == 0)
                 throw std::runtime_error("Error unmapping file");
 
-            if (fHandleFile != nullptr && CloseHandle(fHandleFile) == 0)
+            if (fHandleFile != nullptr && fHandleFile != INVALID_HANDLE_VALUE && CloseHandle(fHandleFile) == 0)
                 throw std::runtime_error("Error unmapping file");
-            fView = fHandleMMF = fHandleFile = nullptr;   
+            fHandleMMF = fHandleFile = nullptr;   
 #elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
-        if (fView != MAP_FAILED && fView != nullptr && munmap(fView, fSize) == -1)
-            throw std::runtime_error("Error mapping file");
-        if (fHandleFile == -1 && close(fHandleFile) == -1)
+        if (fHandleFile != -1 && close(fHandleFile) == -1)
             throw std::runtime_error("Cannot close file");
-            fView = nullptr;
-            fHandleMMF = fHandleFile = 0;
+        fHandleMMF = 0;
+        fHandleFile = -1;
 #endif
-        
+            fFileSize = 0;
         }
 
+        // Start of the mapped view, at GetViewOffset() in the file.
         void* GetBuffer() const
         {
-            return fView;
+            LLUTILS_DISABLE_WARNING_PUSH
+            LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+            return fMapBase != nullptr ? static_cast<std::byte*>(fMapBase) + (fViewOffset - fMapOffset) : nullptr;
+            LLUTILS_DISABLE_WARNING_POP
         }
+
+        // Size of the mapped view, the whole file unless a window is mapped.
         uintmax_t GetSize() const
         {
-            return fSize;
+            return fViewSize;
+        }
+
+        uintmax_t GetViewOffset() const
+        {
+            return fViewOffset;
+        }
+
+        uintmax_t GetFileSize() const
+        {
+            return fFileSize;
+        }
+
+        bool IsWritable() const
+        {
+            return fMode != Mode::ReadOnly;
+        }
+
+        // Offsets passed to the OS must be multiples of this value.
+        static size_t GetAllocationGranularity()
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            static const size_t sGranularity = []
+            {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<size_t>(info.dwAllocationGranularity);
+            }();
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            static const size_t sGranularity = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            return sGranularity;
+        }
+
+        // Replace the view with [offset, offset + length), clamped to the end of the file.
+        // Only the touched pages are mapped, the offset need not be aligned.
+        void MapWindow(uintmax_t offset, size_t length)
+        {
+            if (offset > fFileSize)
+                throw std::runtime_error("Mapping window out of range");
+
+            fWindowed = true;
+            fWindowLength = length;
+            MapRange(offset, static_cast<size_t>((std::min)(static_cast<uintmax_t>(length), fFileSize - offset)));
+        }
+
+        // Map the whole file again after MapWindow.
+        void MapWholeFile()
+        {
+            fWindowed = false;
+            MapRange(0, static_cast<size_t>(fFileSize));
+        }
+
+        // Set the file size and remap the view, the view address may change.
+        // A window is kept as is, clamped to the new file size.
+        void Resize(uintmax_t newSize)
+        {
+            if (IsWritable() == false)
+                throw std::logic_error("Cannot resize a read-only file mapping");
+
+            if (newSize == fFileSize)
+                return;
+
+            // The view may move, the prefetch thread must not touch it meanwhile.
+            CancelPrefetch();
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            // The file can't be resized while a mapping object exists.
+            Unmap();
+            if (fHandleMMF != nullptr && CloseHandle(fHandleMMF) == 0)
+                throw std::runtime_error("Error unmapping file");
+            fHandleMMF = nullptr;
+
+            LARGE_INTEGER size;
+            size.QuadPart = static_cast<LONGLONG>(newSize);
+            if (SetFilePointerEx(fHandleFile, size, nullptr, FILE_BEGIN) == 0 || SetEndOfFile(fHandleFile) == 0)
+                throw std::runtime_error("Cannot resize file");
+
+            fFileSize = newSize;
+            CreateMappingObject();
+            if (fWindowed)
+                MapWindow((std::min)(fViewOffset, fFileSize), fWindowLength);
+            else
+                MapWholeFile();
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        SetFileSize(newSize);
+        const uintmax_t oldSize = fFileSize;
+        fFileSize = newSize;
+        if (fWindowed)
+        {
+            // Remap if the view no longer fits, or if a window clamped by the old size can grow back.
+            if (fViewOffset + fViewSize > newSize || fViewSize < fWindowLength)
+                MapWindow((std::min)(fViewOffset, newSize), fWindowLength);
+        }
+        else if (fMapBase == nullptr || newSize == 0)
+        {
+            MapWholeFile();
+        }
+        else
+        {
+            void* view = mremap(fMapBase, static_cast<size_t>(oldSize), static_cast<size_t>(newSize), MREMAP_MAYMOVE);
+            if (view == MAP_FAILED)
+                throw std::runtime_error("Cannot remap file");
+            fMapBase = view;
+            fMapLength = static_cast<size_t>(newSize);
+            fViewSize = newSize;
+        }
+#endif
+        }
+
+        // Write dirty pages in [offset, offset + size) of the view back to the file, size 0 means up to the end of the view.
+        // async - schedule the write back and return without waiting for it.
+        void Flush(uintmax_t offset = 0, uintmax_t size = 0, bool async = false)
+        {
+            if (fMapBase == nullptr || IsWritable() == false)
+                return;
+
+            ClampRange(offset, size);
+            std::byte* address = static_cast<std::byte*>(GetBuffer()) + offset;
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            if (FlushViewOfFile(address, static_cast<SIZE_T>(size)) == 0)
+                throw std::runtime_error("Cannot flush file mapping");
+            if (async == false && FlushFileBuffers(fHandleFile) == 0)
+                throw std::runtime_error("Cannot flush file");
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        // msync requires a page aligned address.
+        std::byte* aligned = AlignDownToPage(address);
+        if (msync(aligned, static_cast<size_t>(size) + static_cast<size_t>(address - aligned), async ? MS_ASYNC : MS_SYNC) == -1)
+            throw std::runtime_error("Cannot flush file mapping");
+#endif
+        }
+
+        // Tell the OS how [offset, offset + size) of the view is about to be accessed, size 0 means up to the end of the view.
+        // Returns false if the hint is not supported for this mapping, hints never affect the content.
+        bool Advise(Advice advice, uintmax_t offset = 0, uintmax_t size = 0)
+        {
+            if (fMapBase == nullptr)
+                return false;
+
+            ClampRange(offset, size);
+            std::byte* address = static_cast<std::byte*>(GetBuffer()) + offset;
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            switch (advice)
+            {
+            case Advice::WillNeed:
+            {
+                WIN32_MEMORY_RANGE_ENTRY range{ address, static_cast<SIZE_T>(size) };
+                return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+            }
+            case Advice::DontNeed:
+                // Unlocking pages that aren't locked removes them from the working set.
+                VirtualUnlock(address, static_cast<SIZE_T>(size));
+                return true;
+            default:
+                return advice == Advice::Normal;
+            }
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        int memoryAdvice = MADV_NORMAL;
+        int fileAdvice = POSIX_FADV_NORMAL;
+        switch (advice)
+        {
+        case Advice::Normal:
+            break;
+        case Advice::Sequential:
+            memoryAdvice = MADV_SEQUENTIAL;
+            fileAdvice = POSIX_FADV_SEQUENTIAL;
+            break;
+        case Advice::Random:
+            memoryAdvice = MADV_RANDOM;
+            fileAdvice = POSIX_FADV_RANDOM;
+            break;
+        case Advice::WillNeed:
+            memoryAdvice = MADV_WILLNEED;
+            fileAdvice = POSIX_FADV_WILLNEED;
+            break;
+        case Advice::DontNeed:
+            memoryAdvice = MADV_DONTNEED;
+            fileAdvice = POSIX_FADV_DONTNEED;
+            break;
+        case Advice::HugePage:
+            memoryAdvice = MADV_HUGEPAGE;
+            fileAdvice = -1;
+            break;
+        }
+
+        std::byte* aligned = AlignDownToPage(address);
+        if (madvise(aligned, static_cast<size_t>(size) + static_cast<size_t>(address - aligned), memoryAdvice) == -1)
+            return false;
+
+        // The read ahead window of the file itself is controlled by the file advice.
+        // Dirty pages of a writable mapping are not written back by POSIX_FADV_DONTNEED, so skip it there.
+        if (fileAdvice != -1 && (advice != Advice::DontNeed || IsWritable() == false))
+            posix_fadvise64(fHandleFile, static_cast<off64_t>(fViewOffset + offset), static_cast<off64_t>(size), fileAdvice);
+
+        return true;
+#endif
+        }
+
+        // Fault in [offset, offset + size) of the view on a background thread, size 0 means up to the end of the view.
+        // A running prefetch is cancelled when a new one starts or when the view is unmapped.
+        void Prefetch(uintmax_t offset = 0, uintmax_t size = 0)
+        {
+            CancelPrefetch();
+            if (fMapBase == nullptr)
+                return;
+
+            ClampRange(offset, size);
+            Advise(Advice::WillNeed, offset, size);
+
+            const std::byte* begin = static_cast<const std::byte*>(GetBuffer()) + offset;
+            fPrefetchThread = std::thread([this, begin, size = static_cast<size_t>(size)]
+            {
+                const size_t pageSize = GetPageSize();
+                constexpr size_t ChunkSize = size_t{ 2 } << 20;
+                for (size_t chunk = 0; chunk < size && fPrefetchCancel.load(std::memory_order_relaxed) == false; chunk += ChunkSize)
+                {
+                    const size_t chunkEnd = (std::min)(size, chunk + ChunkSize);
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX && defined(MADV_POPULATE_READ)
+                    // Populate the whole chunk with one call where supported.
+                    std::byte* address = const_cast<std::byte*>(begin + chunk);
+                    std::byte* aligned = AlignDownToPage(address);
+                    if (madvise(aligned, chunkEnd - chunk + static_cast<size_t>(address - aligned), MADV_POPULATE_READ) == 0)
+                        continue;
+#endif
+                    for (size_t i = chunk; i < chunkEnd; i += pageSize)
+                        static_cast<void>(*static_cast<const volatile std::byte*>(begin + i));
+                }
+            });
+        }
+
+        // Block until a running prefetch completes.
+        void WaitForPrefetch()
+        {
+            if (fPrefetchThread.joinable())
+                fPrefetchThread.join();
+        }
+
+        void CancelPrefetch()
+        {
+            fPrefetchCancel.store(true, std::memory_order_relaxed);
+            WaitForPrefetch();
+            fPrefetchCancel.store(false, std::memory_order_relaxed);
+        }
+
+        // Page faults taken by the calling thread (Linux) or by the process (Windows).
+        // Windows doesn't split soft and hard faults, there only 'total' is set and minor / major stay 0.
+        struct PageFaults
+        {
+            uint64_t minor{};
+            uint64_t major{}; // Faults that required I/O, i.e. page cache misses.
+            uint64_t total{}; // All faults, minor + major where the split is available.
+
+            PageFaults operator-(const PageFaults& rhs) const
+            {
+                return { minor - rhs.minor, major - rhs.major, total - rhs.total };
+            }
+        };
+
+        static PageFaults GetPageFaults()
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            PROCESS_MEMORY_COUNTERS counters{};
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+                throw std::runtime_error("Cannot query page faults");
+            return { 0, 0, counters.PageFaultCount };
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        rusage usage{};
+        if (getrusage(RUSAGE_THREAD, &usage) == -1)
+            throw std::runtime_error("Cannot query page faults");
+        const uint64_t minor = static_cast<uint64_t>(usage.ru_minflt);
+        const uint64_t major = static_cast<uint64_t>(usage.ru_majflt);
+        return { minor, major, minor + major };
+#endif
+        }
+
+        // Run 'func' on the calling thread and return the page faults it took.
+        template <typename Func>
+        static PageFaults MeasurePageFaults(Func&& func)
+        {
+            const PageFaults before = GetPageFaults();
+            func();
+            return GetPageFaults() - before;
+        }
+
+        // One entry per page covering [offset, offset + size) of the view, size 0 means up to the end of the view.
+        // An entry is true if the page is in memory and accessing it won't block on I/O.
+        std::vector<bool> GetResidency(uintmax_t offset = 0, uintmax_t size = 0) const
+        {
+            if (fMapBase == nullptr)
+                return {};
+
+            ClampRange(offset, size);
+            std::byte* address = static_cast<std::byte*>(GetBuffer()) + offset;
+            std::byte* aligned = AlignDownToPage(address);
+            const size_t pageSize = GetPageSize();
+            const size_t pageCount = (static_cast<size_t>(size) + static_cast<size_t>(address - aligned) + pageSize - 1) / pageSize;
+            std::vector<bool> residency(pageCount);
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            std::vector<PSAPI_WORKING_SET_EX_INFORMATION> pages(pageCount);
+            for (size_t i = 0; i < pageCount; i++)
+                pages[i].VirtualAddress = aligned + i * pageSize;
+
+            if (QueryWorkingSetEx(GetCurrentProcess(), pages.data(), static_cast<DWORD>(pages.size() * sizeof(PSAPI_WORKING_SET_EX_INFORMATION))) == 0)
+                throw std::runtime_error("Cannot query page residency");
+
+            for (size_t i = 0; i < pageCount; i++)
+                residency[i] = pages[i].VirtualAttributes.Valid != 0;
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        std::vector<unsigned char> pages(pageCount);
+        if (mincore(aligned, pageCount * pageSize, pages.data()) == -1)
+            throw std::runtime_error("Cannot query page residency");
+
+        for (size_t i = 0; i < pageCount; i++)
+            residency[i] = (pages[i] & 1) != 0;
+#endif
+            return residency;
+        }
+
+        // Fraction of the pages of [offset, offset + size) of the view that are resident, see GetResidency.
+        double GetResidentRatio(uintmax_t offset = 0, uintmax_t size = 0) const
+        {
+            const std::vector<bool> residency = GetResidency(offset, size);
+            if (residency.empty())
+                return 0.0;
+
+            return static_cast<double>(std::count(residency.begin(), residency.end(), true)) / static_cast<double>(residency.size());
         }
 
     private: //methods
 
+        // Clamp [offset, offset + size) to the view, size 0 means up to the end of the view.
+        void ClampRange(uintmax_t& offset, uintmax_t& size) const
+        {
+            if (offset > fViewSize)
+                throw std::runtime_error("Range out of bounds");
+
+            if (size == 0 || size > fViewSize - offset)
+                size = fViewSize - offset;
+        }
+
         void OpenImp()
         {
 #if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
-            fHandleFile = CreateFile(fFilePath.c_str(), GENERIC_READ,
-                FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+            fHandleFile = CreateFile(fFilePath.c_str(), IsWritable() ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, fMode == Mode::OpenOrCreate ? OPEN_ALWAYS : OPEN_EXISTING,
                 FILE_ATTRIBUTE_NORMAL, nullptr);
 
-            if (fHandleFile != INVALID_HANDLE_VALUE)
-            {
-                fHandleMMF = CreateFileMapping(fHandleFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
-                if (fHandleMMF != nullptr)
-                    fView = MapViewOfFile(fHandleMMF, FILE_MAP_READ, 0, 0, 0);
+            if (fHandleFile == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("Cannot open file");
+
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(fHandleFile, &size) == 0)
+                throw std::runtime_error("Cannot get file information");
+            fFileSize = static_cast<uintmax_t>(size.QuadPart);
 
-                fSize = std::filesystem::file_size(fFilePath);
+            if (IsWritable() && fFileSize < fMinimumSize)
+            {
+                size.QuadPart = static_cast<LONGLONG>(fMinimumSize);
+                if (SetFilePointerEx(fHandleFile, size, nullptr, FILE_BEGIN) == 0 || SetEndOfFile(fHandleFile) == 0)
+                    throw std::runtime_error("Cannot resize file");
+                fFileSize = fMinimumSize;
             }
 
+            CreateMappingObject();
 
 #elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
-        fHandleFile = open(fFilePath.c_str(), O_RDONLY);
+        int flags = O_RDONLY;
+        if (fMode == Mode::ReadWrite)
+            flags = O_RDWR;
+        else if (fMode == Mode::OpenOrCreate)
+            flags = O_RDWR | O_CREAT;
+
+        fHandleFile = open(fFilePath.c_str(), flags | O_CLOEXEC, 0644);
         if (fHandleFile == -1)
             throw std::runtime_error("Cannot open file");
 
@@ -123,20 +542,156 @@ namespace LLUtils
         if (fstat64(fHandleFile, &sb) == -1)
             throw std::runtime_error("Cannot get file information");
 
-        fSize = static_cast<uintmax_t>(sb.st_size);
-        fView = mmap(NULL, fSize, PROT_READ,
-                       MAP_PRIVATE, fHandleFile, 0);
-        if (fView == MAP_FAILED)
+        fFileSize = static_cast<uintmax_t>(sb.st_size);
+        if (IsWritable() && fFileSize < fMinimumSize)
+        {
+            SetFileSize(fMinimumSize);
+            fFileSize = fMinimumSize;
+        }
+#endif
+            if (fWindowed)
+                MapWindow(fViewOffset, fWindowLength);
+            else
+                MapWholeFile();
+        }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+        void CreateMappingObject()
+        {
+            // Empty files can't be mapped.
+            if (fFileSize == 0)
+                return;
+
+            fHandleMMF = CreateFileMapping(fHandleFile, nullptr, IsWritable() ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+            if (fHandleMMF == nullptr)
+                throw std::runtime_error("Cannot map file");
+        }
+#endif
+
+        // Map the pages covering [offset, offset + length) of the file.
+        void MapRange(uintmax_t offset, size_t length)
+        {
+            Unmap();
+            fViewOffset = offset;
+            fViewSize = length;
+
+            // Empty files or windows can't be mapped.
+            if (length == 0)
+                return;
+
+            const uintmax_t mapOffset = offset / GetAllocationGranularity() * GetAllocationGranularity();
+            const size_t mapLength = length + static_cast<size_t>(offset - mapOffset);
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            void* view = MapViewOfFile(fHandleMMF, IsWritable() ? FILE_MAP_WRITE : FILE_MAP_READ,
+                static_cast<DWORD>(mapOffset >> 32), static_cast<DWORD>(mapOffset & 0xFFFFFFFF), mapLength);
+            if (view == nullptr)
+                throw std::runtime_error("Cannot map file");
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        int flags = IsWritable() ? MAP_SHARED : MAP_PRIVATE;
+        if ((fOptions & Options::Populate) == Options::Populate)
+            flags |= MAP_POPULATE;
+
+        void* view = mmap64(NULL, mapLength, IsWritable() ? PROT_READ | PROT_WRITE : PROT_READ, flags, fHandleFile, static_cast<off64_t>(mapOffset));
+        if (view == MAP_FAILED)
             throw std::runtime_error("Cannot map file");
+#endif
+            fMapBase = view;
+            fMapOffset = mapOffset;
+            fMapLength = mapLength;
 
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            if ((fOptions & Options::Populate) == Options::Populate)
+            {
+                WIN32_MEMORY_RANGE_ENTRY range{ view, mapLength };
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            }
 #endif
         }
 
+        void Unmap()
+        {
+            if (fMapBase == nullptr)
+                return;
+
+            CancelPrefetch();
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            if (UnmapViewOfFile(fMapBase) == 0)
+                throw std::runtime_error("Error unmapping file");
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        if (munmap(fMapBase, fMapLength) == -1)
+            throw std::runtime_error("Error unmapping file");
+#endif
+            fMapBase = nullptr;
+            fMapOffset = 0;
+            fMapLength = 0;
+            fViewSize = 0;
+        }
+
+        static size_t GetPageSize()
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            static const size_t sPageSize = []
+            {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<size_t>(info.dwPageSize);
+            }();
+            return sPageSize;
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        return GetAllocationGranularity();
+#endif
+        }
+
+        static std::byte* AlignDownToPage(std::byte* address)
+        {
+            const std::uintptr_t pageSize = static_cast<std::uintptr_t>(GetPageSize());
+            return reinterpret_cast<std::byte*>(reinterpret_cast<std::uintptr_t>(address) / pageSize * pageSize);
+        }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+
+        void SetFileSize(uintmax_t newSize)
+        {
+            // Allocate the blocks up front so running out of disk space fails here rather than with SIGBUS on first write.
+            if (newSize > fFileSize)
+            {
+                const int result = posix_fallocate64(fHandleFile, static_cast<off64_t>(fFileSize), static_cast<off64_t>(newSize - fFileSize));
+                if (result == 0)
+                    return;
+                if (result != EOPNOTSUPP && result != EINVAL)
+                    throw std::runtime_error("Cannot resize file");
+            }
+
+            if (ftruncate64(fHandleFile, static_cast<off64_t>(newSize)) == -1)
+                throw std::runtime_error("Cannot resize file");
+        }
+#endif
+
     private: // member fields
         const native_string_type fFilePath;
-        uintmax_t fSize{};
+        Mode fMode = Mode::ReadOnly;
+        Options fOptions = Options::None;
+        uintmax_t fMinimumSize{};
+        uintmax_t fFileSize{};
+        bool fWindowed = false;
+        // Window length as requested by the user, the view may be clamped to the file size.
+        size_t fWindowLength{};
+        // The current view, clamped to the file size.
+        uintmax_t fViewOffset{};
+        uintmax_t fViewSize{};
+        // The actual mapping, starting at an aligned offset at or before the view.
+        void* fMapBase = nullptr;
+        uintmax_t fMapOffset{};
+        size_t fMapLength{};
         NATIVE_HANDLE fHandleMMF{};
+        std::thread fPrefetchThread;
+        std::atomic<bool> fPrefetchCancel = false;
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        NATIVE_HANDLE fHandleFile = -1;
+#else
         NATIVE_HANDLE fHandleFile{};
-        void *fView = nullptr;
+#endif
     };
 }
\ No newline at end of file
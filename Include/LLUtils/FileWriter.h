@@ -0,0 +1,296 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Platform.h>
+#include <LLUtils/StringDefs.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+    #include <Windows.h>
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace LLUtils
+{
+    // Long lived buffered file writer, an alternative to File::WriteAllBytes / WriteAllText for repeated writes.
+    // Writes are collected in a user space buffer and written when it fills, when the flush interval elapses,
+    // or on Flush. Data that doesn't fit the buffer is written together with the buffered data in one writev call.
+    // Data is only guaranteed to reach the disk after Sync, or after every flush with Options::durable.
+    // Thread safe.
+    class FileWriter
+    {
+    public:
+        enum class Mode
+        {
+              Append
+            , Truncate
+        };
+
+        struct Options
+        {
+            Mode mode = Mode::Append;
+            // Buffered bytes that trigger a flush, 0 writes every call straight to the file.
+            size_t bufferSize = 1024 * 1024;
+            // Flush buffered data from a background thread on this fixed period, 0 disables.
+            std::chrono::milliseconds flushInterval{ 0 };
+            // fdatasync (FlushFileBuffers on Windows) after every flush.
+            bool durable = false;
+        };
+
+        FileWriter(const native_string_type& filePath) : FileWriter(filePath, Options{})
+        {
+
+        }
+
+        FileWriter(const native_string_type& filePath, const Options& options) : fOptions(options)
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            fHandle = CreateFile(filePath.c_str(), options.mode == Mode::Append ? FILE_APPEND_DATA : GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr, options.mode == Mode::Append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (fHandle == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("Cannot open file");
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            fHandle = open(filePath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (options.mode == Mode::Append ? O_APPEND : O_TRUNC), 0644);
+            if (fHandle == -1)
+                throw std::runtime_error("Cannot open file");
+#endif
+            fBuffer.Reserve(options.bufferSize);
+            if (options.flushInterval.count() > 0)
+                fFlushThread = std::thread(&FileWriter::FlushLoop, this);
+        }
+
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+
+        // Flushes the buffered data, errors are ignored, call Flush or Sync first to handle them.
+        ~FileWriter()
+        {
+            if (fFlushThread.joinable())
+            {
+                {
+                    std::lock_guard lock(fMutex);
+                    fStop = true;
+                }
+                fFlushCondition.notify_one();
+                fFlushThread.join();
+            }
+
+            try
+            {
+                Flush();
+            }
+            catch (...)
+            {
+            }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            CloseHandle(fHandle);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            close(fHandle);
+#endif
+        }
+
+        void Write(const std::byte* data, size_t size)
+        {
+            std::lock_guard lock(fMutex);
+            if (fBuffer.size() + size < fOptions.bufferSize)
+            {
+                fBuffer.Append(data, size);
+                return;
+            }
+
+            // Full, write the buffered data followed by the new data without copying it.
+            WriteBuffered(data, size);
+            if (fOptions.durable)
+                SyncImp();
+        }
+
+        void Write(std::span<const std::byte> data)
+        {
+            Write(data.data(), data.size());
+        }
+
+        void Write(std::string_view text)
+        {
+            Write(reinterpret_cast<const std::byte*>(text.data()), text.size());
+        }
+
+        // Write the buffered data to the file.
+        void Flush()
+        {
+            std::lock_guard lock(fMutex);
+            FlushImp();
+        }
+
+        // Write the buffered data and wait until it and everything written before reaches the disk.
+        void Sync()
+        {
+            std::lock_guard lock(fMutex);
+            FlushImp();
+            if (fOptions.durable == false)
+                SyncImp();
+        }
+
+        size_t GetBufferedSize() const
+        {
+            std::lock_guard lock(fMutex);
+            return fBuffer.size();
+        }
+
+    private:
+        void FlushImp()
+        {
+            if (fBuffer.size() == 0)
+                return;
+
+            WriteBuffered(nullptr, 0);
+            if (fOptions.durable)
+                SyncImp();
+        }
+
+        void FlushLoop()
+        {
+            std::unique_lock lock(fMutex);
+            while (fStop == false)
+            {
+                if (fFlushCondition.wait_for(lock, fOptions.flushInterval, [this] { return fStop; }))
+                    break;
+                try
+                {
+                    FlushImp();
+                }
+                catch (...)
+                {
+                    // Keep the data buffered, it's retried on the next flush.
+                }
+            }
+        }
+
+        // Write the buffered data followed by the given data and empty the buffer.
+        // On failure only the buffered bytes that were not written yet are kept, so they aren't written twice.
+        void WriteBuffered(const std::byte* data, size_t size)
+        {
+            size_t firstWritten = 0;
+            try
+            {
+                WriteImp(fBuffer.data(), fBuffer.size(), data, size, firstWritten);
+            }
+            catch (...)
+            {
+                const size_t remaining = fBuffer.size() - firstWritten;
+                std::memmove(fBuffer.data(), fBuffer.data() + firstWritten, remaining);
+                fBuffer.Resize(remaining);
+                throw;
+            }
+            fBuffer.Resize(0);
+        }
+
+        // Write both ranges in order, as one system call where possible, firstWritten counts the bytes of the first range written.
+        void WriteImp(const std::byte* first, size_t firstSize, const std::byte* second, size_t secondSize, size_t& firstWritten)
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            WriteAll(first, firstSize, firstWritten);
+            size_t secondWritten = 0;
+            WriteAll(second, secondSize, secondWritten);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            iovec vec[2] = { { const_cast<std::byte*>(first), firstSize }, { const_cast<std::byte*>(second), secondSize } };
+            size_t index = firstSize == 0 ? 1 : 0;
+            const size_t count = secondSize == 0 ? 1 : 2;
+            while (index < count)
+            {
+                const ssize_t written = writev(fHandle, vec + index, static_cast<int>(count - index));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error("Cannot write to file");
+                }
+
+                size_t remaining = static_cast<size_t>(written);
+                firstWritten += index == 0 ? (std::min)(remaining, vec[0].iov_len) : 0;
+                while (index < count && remaining >= vec[index].iov_len)
+                    remaining -= vec[index++].iov_len;
+
+                if (remaining > 0)
+                {
+                    vec[index].iov_base = static_cast<std::byte*>(vec[index].iov_base) + remaining;
+                    vec[index].iov_len -= remaining;
+                }
+            }
+#endif
+        }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+        void WriteAll(const std::byte* data, size_t size, size_t& totalWritten)
+        {
+            while (size > 0)
+            {
+                DWORD written = 0;
+                if (WriteFile(fHandle, data, static_cast<DWORD>(std::min<size_t>(size, 1u << 30)), &written, nullptr) == 0)
+                    throw std::runtime_error("Cannot write to file");
+                data += written;
+                size -= written;
+                totalWritten += written;
+            }
+        }
+#endif
+
+        void SyncImp()
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            if (FlushFileBuffers(fHandle) == 0)
+                throw std::runtime_error("Cannot flush file");
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            if (fdatasync(fHandle) == -1)
+                throw std::runtime_error("Cannot flush file");
+#endif
+        }
+
+    private:
+        const Options fOptions;
+        LLUtils::Buffer fBuffer;
+        mutable std::mutex fMutex;
+        std::condition_variable fFlushCondition;
+        std::thread fFlushThread;
+        bool fStop = false;
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+        HANDLE fHandle;
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        int fHandle;
+#endif
+    };
+}
@@ -0,0 +1,962 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Endian.h>
+#include <LLUtils/FileMapping.h>
+#include <LLUtils/Platform.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define LLUTILS_HASH_X64 1
+    #include <immintrin.h>
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC
+        #include <intrin.h>
+    #endif
+#else
+    #define LLUTILS_HASH_X64 0
+#endif
+
+#if defined(__aarch64__) && (LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG)
+    #define LLUTILS_HASH_ARM64 1
+    #include <arm_acle.h>
+    #if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        #include <sys/auxv.h>
+        #include <asm/hwcap.h>
+    #endif
+#else
+    #define LLUTILS_HASH_ARM64 0
+#endif
+
+namespace LLUtils
+{
+    // Helpers to hash the different byte containers used across LLUtils.
+    template <typename Hasher>
+    class HashInputs
+    {
+    public:
+        static auto Compute(std::span<const std::byte> data, typename Hasher::Seed_t seed = {})
+        {
+            return Hasher::Compute(data.data(), data.size(), seed);
+        }
+
+        template <typename Alloc, size_t InlineBytes>
+        static auto Compute(const BufferBase<Alloc, InlineBytes>& buffer, typename Hasher::Seed_t seed = {})
+        {
+            return Hasher::Compute(buffer.data(), buffer.size(), seed);
+        }
+
+        static auto Compute(const FileMapping& mapping, typename Hasher::Seed_t seed = {})
+        {
+            return Hasher::Compute(mapping.GetBuffer(), static_cast<size_t>(mapping.GetSize()), seed);
+        }
+    };
+
+
+    // XXH64, bit compatible with the reference implementation.
+    // Streaming: construct, Update() any number of times, Digest().
+    class XXHash64
+    {
+    public:
+        using Seed_t = uint64_t;
+        using Inputs = HashInputs<XXHash64>;
+
+        XXHash64(uint64_t seed = 0)
+        {
+            Reset(seed);
+        }
+
+        void Reset(uint64_t seed = 0)
+        {
+            fSeed = seed;
+            fAccumulators = { seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 };
+            fTotalLength = 0;
+            fPendingSize = 0;
+        }
+
+        void Update(const void* data, size_t size)
+        {
+            const std::byte* input = static_cast<const std::byte*>(data);
+            fTotalLength += size;
+
+            if (fPendingSize + size < StripeSize)
+            {
+                if (size > 0)
+                    memcpy(fPending.data() + fPendingSize, input, size);
+                fPendingSize += size;
+                return;
+            }
+
+            if (fPendingSize > 0)
+            {
+                const size_t fill = StripeSize - fPendingSize;
+                memcpy(fPending.data() + fPendingSize, input, fill);
+                ConsumeStripe(fPending.data());
+                input += fill;
+                size -= fill;
+                fPendingSize = 0;
+            }
+
+            while (size >= StripeSize)
+            {
+                ConsumeStripe(input);
+                input += StripeSize;
+                size -= StripeSize;
+            }
+
+            if (size > 0)
+                memcpy(fPending.data(), input, size);
+            fPendingSize = size;
+        }
+
+        void Update(std::span<const std::byte> data)
+        {
+            Update(data.data(), data.size());
+        }
+
+        uint64_t Digest() const
+        {
+            uint64_t hash;
+            if (fTotalLength >= StripeSize)
+            {
+                const auto& v = fAccumulators;
+                hash = std::rotl(v[0], 1) + std::rotl(v[1], 7) + std::rotl(v[2], 12) + std::rotl(v[3], 18);
+                for (uint64_t lane : v)
+                    hash = MergeRound(hash, lane);
+            }
+            else
+            {
+                hash = fSeed + Prime5;
+            }
+
+            hash += fTotalLength;
+            return Finalize(hash, fPending.data(), fPendingSize);
+        }
+
+        static uint64_t Compute(const void* data, size_t size, uint64_t seed = 0)
+        {
+            XXHash64 hasher(seed);
+            hasher.Update(data, size);
+            return hasher.Digest();
+        }
+
+    private:
+        static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+        static constexpr size_t StripeSize = 32;
+
+        static uint64_t Round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * Prime2;
+            accumulator = std::rotl(accumulator, 31);
+            return accumulator * Prime1;
+        }
+
+        static uint64_t MergeRound(uint64_t hash, uint64_t lane)
+        {
+            hash ^= Round(0, lane);
+            return hash * Prime1 + Prime4;
+        }
+
+        void ConsumeStripe(const std::byte* stripe)
+        {
+            for (size_t i = 0; i < 4; i++)
+                fAccumulators[i] = Round(fAccumulators[i], Endian::Load<uint64_t>(stripe + i * 8));
+        }
+
+        static uint64_t Finalize(uint64_t hash, const std::byte* tail, size_t size)
+        {
+            while (size >= 8)
+            {
+                hash ^= Round(0, Endian::Load<uint64_t>(tail));
+                hash = std::rotl(hash, 27) * Prime1 + Prime4;
+                tail += 8;
+                size -= 8;
+            }
+
+            if (size >= 4)
+            {
+                hash ^= static_cast<uint64_t>(Endian::Load<uint32_t>(tail)) * Prime1;
+                hash = std::rotl(hash, 23) * Prime2 + Prime3;
+                tail += 4;
+                size -= 4;
+            }
+
+            while (size > 0)
+            {
+                hash ^= static_cast<uint64_t>(static_cast<uint8_t>(*tail)) * Prime5;
+                hash = std::rotl(hash, 11) * Prime1;
+                tail++;
+                size--;
+            }
+
+            hash ^= hash >> 33;
+            hash *= Prime2;
+            hash ^= hash >> 29;
+            hash *= Prime3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        std::array<uint64_t, 4> fAccumulators;
+        std::array<std::byte, StripeSize> fPending;
+        uint64_t fSeed;
+        uint64_t fTotalLength;
+        size_t fPendingSize;
+    };
+
+
+    // 128 bit hash value, see XXHash3_128.
+    struct Hash128
+    {
+        uint64_t low;
+        uint64_t high;
+
+        bool operator==(const Hash128&) const = default;
+    };
+
+
+    // XXH3 64 / 128 bit, bit compatible with the reference implementation (default secret).
+    // Inputs up to 240 bytes are hashed directly, longer inputs stream through 8 accumulator lanes (SSE2 on x86-64).
+    // Streaming: construct, Update() any number of times, Digest().
+    template <size_t Bits>
+    class XXHash3Base
+    {
+    public:
+        static_assert(Bits == 64 || Bits == 128, "XXH3 produces 64 or 128 bit hashes");
+
+        using Seed_t = uint64_t;
+        using Digest_t = std::conditional_t<Bits == 64, uint64_t, Hash128>;
+        using Inputs = HashInputs<XXHash3Base>;
+
+        XXHash3Base(uint64_t seed = 0)
+        {
+            Reset(seed);
+        }
+
+        void Reset(uint64_t seed = 0)
+        {
+            fSeed = seed;
+            fSecret = MakeSecret(seed);
+            fAccumulators = InitialAccumulators;
+            fTotalLength = 0;
+            fPendingSize = 0;
+            fStripesInBlock = 0;
+        }
+
+        void Update(const void* data, size_t size)
+        {
+            const std::byte* input = static_cast<const std::byte*>(data);
+            fTotalLength += size;
+
+            // Always keep at least one byte pending, Digest treats the last stripe separately.
+            if (fPendingSize + size <= PendingCapacity)
+            {
+                if (size > 0)
+                    memcpy(fPending.data() + fPendingSize, input, size);
+                fPendingSize += size;
+                return;
+            }
+
+            if (fPendingSize > 0)
+            {
+                const size_t fill = PendingCapacity - fPendingSize;
+                memcpy(fPending.data() + fPendingSize, input, fill);
+                ConsumeStripes(fAccumulators, fStripesInBlock, fPending.data(), PendingStripes, fSecret.data());
+                input += fill;
+                size -= fill;
+                fPendingSize = 0;
+            }
+
+            if (size > PendingCapacity)
+            {
+                do
+                {
+                    ConsumeStripes(fAccumulators, fStripesInBlock, input, PendingStripes, fSecret.data());
+                    input += PendingCapacity;
+                    size -= PendingCapacity;
+                } while (size > PendingCapacity);
+
+                // Keep the previous stripe, the last stripe may overlap it.
+                memcpy(fPending.data() + PendingCapacity - StripeSize, input - StripeSize, StripeSize);
+            }
+
+            memcpy(fPending.data(), input, size);
+            fPendingSize = size;
+        }
+
+        void Update(std::span<const std::byte> data)
+        {
+            Update(data.data(), data.size());
+        }
+
+        Digest_t Digest() const
+        {
+            if (fTotalLength <= MidSizeMax)
+                return HashShort(fPending.data(), static_cast<size_t>(fTotalLength), fSeed);
+
+            Accumulators_t accumulators = fAccumulators;
+            if (fPendingSize >= StripeSize)
+            {
+                size_t stripesInBlock = fStripesInBlock;
+                ConsumeStripes(accumulators, stripesInBlock, fPending.data(), (fPendingSize - 1) / StripeSize, fSecret.data());
+                Accumulate512(accumulators, fPending.data() + fPendingSize - StripeSize, fSecret.data() + LastStripeSecretOffset);
+            }
+            else
+            {
+                // The last stripe spans the previous stripe kept at the end of the pending buffer.
+                std::array<std::byte, StripeSize> lastStripe;
+                const size_t carry = StripeSize - fPendingSize;
+                memcpy(lastStripe.data(), fPending.data() + PendingCapacity - carry, carry);
+                memcpy(lastStripe.data() + carry, fPending.data(), fPendingSize);
+                Accumulate512(accumulators, lastStripe.data(), fSecret.data() + LastStripeSecretOffset);
+            }
+
+            return MergeLong(accumulators, fSecret.data(), fTotalLength);
+        }
+
+        static Digest_t Compute(const void* data, size_t size, uint64_t seed = 0)
+        {
+            const std::byte* input = static_cast<const std::byte*>(data);
+            if (size <= MidSizeMax)
+                return HashShort(input, size, seed);
+
+            const Secret_t secret = MakeSecret(seed);
+            Accumulators_t accumulators = InitialAccumulators;
+            const size_t blockSize = StripeSize * StripesPerBlock;
+            const size_t blocks = (size - 1) / blockSize;
+            for (size_t block = 0; block < blocks; block++)
+            {
+                Accumulate(accumulators, input + block * blockSize, secret.data(), StripesPerBlock);
+                Scramble(accumulators, secret.data() + SecretSize - StripeSize);
+            }
+
+            const size_t stripes = ((size - 1) - blockSize * blocks) / StripeSize;
+            Accumulate(accumulators, input + blocks * blockSize, secret.data(), stripes);
+            Accumulate512(accumulators, input + size - StripeSize, secret.data() + LastStripeSecretOffset);
+            return MergeLong(accumulators, secret.data(), size);
+        }
+
+    private:
+        static constexpr uint32_t Prime32_1 = 0x9E3779B1U;
+        static constexpr uint32_t Prime32_2 = 0x85EBCA77U;
+        static constexpr uint32_t Prime32_3 = 0xC2B2AE3DU;
+        static constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ULL;
+        static constexpr uint64_t PrimeMx1 = 0x165667919E3779F9ULL;
+        static constexpr uint64_t PrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+        static constexpr size_t SecretSize = 192;
+        static constexpr size_t StripeSize = 64;
+        static constexpr size_t StripesPerBlock = (SecretSize - StripeSize) / 8;
+        static constexpr size_t PendingCapacity = 256;
+        static constexpr size_t PendingStripes = PendingCapacity / StripeSize;
+        static constexpr size_t MidSizeMax = 240;
+        static constexpr size_t LastStripeSecretOffset = SecretSize - StripeSize - 7;
+
+        using Secret_t = std::array<std::byte, SecretSize>;
+        using Accumulators_t = std::array<uint64_t, 8>;
+
+        static constexpr Accumulators_t InitialAccumulators = { Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1 };
+
+        static constexpr uint8_t DefaultSecret[SecretSize] =
+        {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        static uint64_t Read64(const std::byte* data)
+        {
+            return Endian::Load<uint64_t>(data);
+        }
+
+        static uint32_t Read32(const std::byte* data)
+        {
+            return Endian::Load<uint32_t>(data);
+        }
+
+        static const std::byte* GetDefaultSecret()
+        {
+            return reinterpret_cast<const std::byte*>(DefaultSecret);
+        }
+
+        // Long inputs use the default secret with the seed folded in, short inputs use the seed directly.
+        static Secret_t MakeSecret(uint64_t seed)
+        {
+            Secret_t secret;
+            const std::byte* source = GetDefaultSecret();
+            for (size_t i = 0; i < SecretSize; i += 16)
+            {
+                Endian::Store<uint64_t>(secret.data() + i, Read64(source + i) + seed);
+                Endian::Store<uint64_t>(secret.data() + i + 8, Read64(source + i + 8) - seed);
+            }
+            return secret;
+        }
+
+        static Hash128 Multiply128(uint64_t lhs, uint64_t rhs)
+        {
+#if defined(__SIZEOF_INT128__)
+            // __extension__ keeps -Wpedantic quiet about the non-standard type.
+            __extension__ typedef unsigned __int128 UInt128;
+            const UInt128 product = static_cast<UInt128>(lhs) * rhs;
+            return { static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+#elif LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC && defined(_M_X64)
+            uint64_t high;
+            const uint64_t low = _umul128(lhs, rhs, &high);
+            return { low, high };
+#else
+            const uint64_t loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+            const uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+            const uint64_t loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+            const uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+            const uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+            return { (cross << 32) | (loLo & 0xFFFFFFFF), (hiLo >> 32) + (cross >> 32) + hiHi };
+#endif
+        }
+
+        static uint64_t MultiplyFold64(uint64_t lhs, uint64_t rhs)
+        {
+            const Hash128 product = Multiply128(lhs, rhs);
+            return product.low ^ product.high;
+        }
+
+        static uint64_t Avalanche64(uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= Prime64_2;
+            hash ^= hash >> 29;
+            hash *= Prime64_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        static uint64_t Avalanche(uint64_t hash)
+        {
+            hash ^= hash >> 37;
+            hash *= PrimeMx1;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        static uint64_t Rrmxmx(uint64_t hash, uint64_t length)
+        {
+            hash ^= std::rotl(hash, 49) ^ std::rotl(hash, 24);
+            hash *= PrimeMx2;
+            hash ^= (hash >> 35) + length;
+            hash *= PrimeMx2;
+            return hash ^ (hash >> 28);
+        }
+
+        static uint64_t Mix16(const std::byte* input, const std::byte* secret, uint64_t seed)
+        {
+            return MultiplyFold64(Read64(input) ^ (Read64(secret) + seed), Read64(input + 8) ^ (Read64(secret + 8) - seed));
+        }
+
+        static void Mix32(Hash128& accumulator, const std::byte* input1, const std::byte* input2, const std::byte* secret, uint64_t seed)
+        {
+            accumulator.low += Mix16(input1, secret, seed);
+            accumulator.low ^= Read64(input2) + Read64(input2 + 8);
+            accumulator.high += Mix16(input2, secret + 16, seed);
+            accumulator.high ^= Read64(input1) + Read64(input1 + 8);
+        }
+
+        static Digest_t HashShort(const std::byte* input, size_t size, uint64_t seed)
+        {
+            const std::byte* secret = GetDefaultSecret();
+            if constexpr (Bits == 64)
+            {
+                if (size > 128)
+                    return Hash129To240_64(input, size, secret, seed);
+                if (size > 16)
+                    return Hash17To128_64(input, size, secret, seed);
+                if (size > 8)
+                    return Hash9To16_64(input, size, secret, seed);
+                if (size >= 4)
+                    return Hash4To8_64(input, size, secret, seed);
+                if (size > 0)
+                    return Hash1To3_64(input, size, secret, seed);
+                return Avalanche64(seed ^ Read64(secret + 56) ^ Read64(secret + 64));
+            }
+            else
+            {
+                if (size > 128)
+                    return Hash129To240_128(input, size, secret, seed);
+                if (size > 16)
+                    return Hash17To128_128(input, size, secret, seed);
+                if (size > 8)
+                    return Hash9To16_128(input, size, secret, seed);
+                if (size >= 4)
+                    return Hash4To8_128(input, size, secret, seed);
+                if (size > 0)
+                    return Hash1To3_128(input, size, secret, seed);
+                return { Avalanche64(seed ^ Read64(secret + 64) ^ Read64(secret + 72)), Avalanche64(seed ^ Read64(secret + 80) ^ Read64(secret + 88)) };
+            }
+        }
+
+        static uint32_t Combine1To3(const std::byte* input, size_t size)
+        {
+            const uint32_t c1 = static_cast<uint8_t>(input[0]);
+            const uint32_t c2 = static_cast<uint8_t>(input[size >> 1]);
+            const uint32_t c3 = static_cast<uint8_t>(input[size - 1]);
+            return (c1 << 16) | (c2 << 24) | c3 | (static_cast<uint32_t>(size) << 8);
+        }
+
+        static uint64_t Hash1To3_64(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            const uint64_t bitflip = (Read32(secret) ^ Read32(secret + 4)) + seed;
+            return Avalanche64(Combine1To3(input, size) ^ bitflip);
+        }
+
+        static uint64_t Hash4To8_64(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            seed ^= static_cast<uint64_t>(Endian::ByteSwap(static_cast<uint32_t>(seed))) << 32;
+            const uint64_t input64 = Read32(input + size - 4) + (static_cast<uint64_t>(Read32(input)) << 32);
+            const uint64_t bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+            return Rrmxmx(input64 ^ bitflip, size);
+        }
+
+        static uint64_t Hash9To16_64(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            const uint64_t bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+            const uint64_t bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+            const uint64_t low = Read64(input) ^ bitflip1;
+            const uint64_t high = Read64(input + size - 8) ^ bitflip2;
+            return Avalanche(size + Endian::ByteSwap(low) + high + MultiplyFold64(low, high));
+        }
+
+        static uint64_t Hash17To128_64(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            uint64_t accumulator = size * Prime64_1;
+            if (size > 32)
+            {
+                if (size > 64)
+                {
+                    if (size > 96)
+                    {
+                        accumulator += Mix16(input + 48, secret + 96, seed);
+                        accumulator += Mix16(input + size - 64, secret + 112, seed);
+                    }
+                    accumulator += Mix16(input + 32, secret + 64, seed);
+                    accumulator += Mix16(input + size - 48, secret + 80, seed);
+                }
+                accumulator += Mix16(input + 16, secret + 32, seed);
+                accumulator += Mix16(input + size - 32, secret + 48, seed);
+            }
+            accumulator += Mix16(input, secret, seed);
+            accumulator += Mix16(input + size - 16, secret + 16, seed);
+            return Avalanche(accumulator);
+        }
+
+        static uint64_t Hash129To240_64(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            uint64_t accumulator = size * Prime64_1;
+            const size_t rounds = size / 16;
+            for (size_t i = 0; i < 8; i++)
+                accumulator += Mix16(input + 16 * i, secret + 16 * i, seed);
+
+            accumulator = Avalanche(accumulator);
+            for (size_t i = 8; i < rounds; i++)
+                accumulator += Mix16(input + 16 * i, secret + 16 * (i - 8) + 3, seed);
+
+            accumulator += Mix16(input + size - 16, secret + 136 - 17, seed);
+            return Avalanche(accumulator);
+        }
+
+        static Hash128 Hash1To3_128(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            const uint32_t combinedLow = Combine1To3(input, size);
+            const uint32_t combinedHigh = std::rotl(Endian::ByteSwap(combinedLow), 13);
+            const uint64_t bitflipLow = (Read32(secret) ^ Read32(secret + 4)) + seed;
+            const uint64_t bitflipHigh = (Read32(secret + 8) ^ Read32(secret + 12)) - seed;
+            return { Avalanche64(combinedLow ^ bitflipLow), Avalanche64(combinedHigh ^ bitflipHigh) };
+        }
+
+        static Hash128 Hash4To8_128(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            seed ^= static_cast<uint64_t>(Endian::ByteSwap(static_cast<uint32_t>(seed))) << 32;
+            const uint64_t input64 = Read32(input) + (static_cast<uint64_t>(Read32(input + size - 4)) << 32);
+            const uint64_t bitflip = (Read64(secret + 16) ^ Read64(secret + 24)) + seed;
+            Hash128 product = Multiply128(input64 ^ bitflip, Prime64_1 + (size << 2));
+            product.high += product.low << 1;
+            product.low ^= product.high >> 3;
+            product.low ^= product.low >> 35;
+            product.low *= PrimeMx2;
+            product.low ^= product.low >> 28;
+            product.high = Avalanche(product.high);
+            return product;
+        }
+
+        static Hash128 Hash9To16_128(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            const uint64_t bitflipLow = (Read64(secret + 32) ^ Read64(secret + 40)) - seed;
+            const uint64_t bitflipHigh = (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+            const uint64_t inputLow = Read64(input);
+            uint64_t inputHigh = Read64(input + size - 8);
+            Hash128 product = Multiply128(inputLow ^ inputHigh ^ bitflipLow, Prime64_1);
+            product.low += static_cast<uint64_t>(size - 1) << 54;
+            inputHigh ^= bitflipHigh;
+            product.high += inputHigh + static_cast<uint64_t>(static_cast<uint32_t>(inputHigh)) * (Prime32_2 - 1);
+            product.low ^= Endian::ByteSwap(product.high);
+
+            Hash128 hash = Multiply128(product.low, Prime64_2);
+            hash.high += product.high * Prime64_2;
+            return { Avalanche(hash.low), Avalanche(hash.high) };
+        }
+
+        static Hash128 Finalize128(const Hash128& accumulator, size_t size, uint64_t seed)
+        {
+            const uint64_t low = accumulator.low + accumulator.high;
+            const uint64_t high = accumulator.low * Prime64_1 + accumulator.high * Prime64_4 + (size - seed) * Prime64_2;
+            return { Avalanche(low), 0 - Avalanche(high) };
+        }
+
+        static Hash128 Hash17To128_128(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            Hash128 accumulator = { size * Prime64_1, 0 };
+            if (size > 32)
+            {
+                if (size > 64)
+                {
+                    if (size > 96)
+                        Mix32(accumulator, input + 48, input + size - 64, secret + 96, seed);
+                    Mix32(accumulator, input + 32, input + size - 48, secret + 64, seed);
+                }
+                Mix32(accumulator, input + 16, input + size - 32, secret + 32, seed);
+            }
+            Mix32(accumulator, input, input + size - 16, secret, seed);
+            return Finalize128(accumulator, size, seed);
+        }
+
+        static Hash128 Hash129To240_128(const std::byte* input, size_t size, const std::byte* secret, uint64_t seed)
+        {
+            Hash128 accumulator = { size * Prime64_1, 0 };
+            const size_t rounds = size / 32;
+            for (size_t i = 0; i < 4; i++)
+                Mix32(accumulator, input + 32 * i, input + 32 * i + 16, secret + 32 * i, seed);
+
+            accumulator = { Avalanche(accumulator.low), Avalanche(accumulator.high) };
+            for (size_t i = 4; i < rounds; i++)
+                Mix32(accumulator, input + 32 * i, input + 32 * i + 16, secret + 32 * (i - 4) + 3, seed);
+
+            Mix32(accumulator, input + size - 16, input + size - 32, secret + 136 - 17 - 16, 0 - seed);
+            return Finalize128(accumulator, size, seed);
+        }
+
+        static void Accumulate512(Accumulators_t& accumulators, const std::byte* input, const std::byte* secret)
+        {
+#if LLUTILS_HASH_X64
+            for (size_t i = 0; i < 4; i++)
+            {
+                __m128i* lane = reinterpret_cast<__m128i*>(accumulators.data()) + i;
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+                const __m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+                const __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+                const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                _mm_storeu_si128(lane, _mm_add_epi64(product, _mm_add_epi64(_mm_loadu_si128(lane), swapped)));
+            }
+#else
+            for (size_t i = 0; i < 8; i++)
+            {
+                const uint64_t data = Read64(input + 8 * i);
+                const uint64_t key = data ^ Read64(secret + 8 * i);
+                accumulators[i ^ 1] += data;
+                accumulators[i] += (key & 0xFFFFFFFF) * (key >> 32);
+            }
+#endif
+        }
+
+        static void Scramble(Accumulators_t& accumulators, const std::byte* secret)
+        {
+#if LLUTILS_HASH_X64
+            const __m128i prime = _mm_set1_epi32(static_cast<int>(Prime32_1));
+            for (size_t i = 0; i < 4; i++)
+            {
+                __m128i* lane = reinterpret_cast<__m128i*>(accumulators.data()) + i;
+                const __m128i value = _mm_loadu_si128(lane);
+                const __m128i key = _mm_xor_si128(_mm_xor_si128(value, _mm_srli_epi64(value, 47)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+                const __m128i productLow = _mm_mul_epu32(key, prime);
+                const __m128i productHigh = _mm_mul_epu32(_mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                _mm_storeu_si128(lane, _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32)));
+            }
+#else
+            for (size_t i = 0; i < 8; i++)
+            {
+                uint64_t value = accumulators[i];
+                value ^= value >> 47;
+                value ^= Read64(secret + 8 * i);
+                accumulators[i] = value * Prime32_1;
+            }
+#endif
+        }
+
+        static void Accumulate(Accumulators_t& accumulators, const std::byte* input, const std::byte* secret, size_t stripes)
+        {
+            for (size_t i = 0; i < stripes; i++)
+                Accumulate512(accumulators, input + i * StripeSize, secret + i * 8);
+        }
+
+        // Streaming counterpart of the block loop in Compute, scrambles whenever a block of stripes completes.
+        static void ConsumeStripes(Accumulators_t& accumulators, size_t& stripesInBlock, const std::byte* input, size_t stripes, const std::byte* secret)
+        {
+            const size_t stripesToBlockEnd = StripesPerBlock - stripesInBlock;
+            if (stripes >= stripesToBlockEnd)
+            {
+                Accumulate(accumulators, input, secret + stripesInBlock * 8, stripesToBlockEnd);
+                Scramble(accumulators, secret + SecretSize - StripeSize);
+                stripesInBlock = stripes - stripesToBlockEnd;
+                Accumulate(accumulators, input + stripesToBlockEnd * StripeSize, secret, stripesInBlock);
+            }
+            else
+            {
+                Accumulate(accumulators, input, secret + stripesInBlock * 8, stripes);
+                stripesInBlock += stripes;
+            }
+        }
+
+        static uint64_t MergeAccumulators(const Accumulators_t& accumulators, const std::byte* secret, uint64_t start)
+        {
+            uint64_t result = start;
+            for (size_t i = 0; i < 4; i++)
+                result += MultiplyFold64(accumulators[2 * i] ^ Read64(secret + 16 * i), accumulators[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+            return Avalanche(result);
+        }
+
+        static Digest_t MergeLong(const Accumulators_t& accumulators, const std::byte* secret, uint64_t size)
+        {
+            const uint64_t low = MergeAccumulators(accumulators, secret + 11, size * Prime64_1);
+            if constexpr (Bits == 64)
+                return low;
+            else
+                return Hash128{ low, MergeAccumulators(accumulators, secret + SecretSize - StripeSize - 11, ~(size * Prime64_2)) };
+        }
+
+        alignas(16) Accumulators_t fAccumulators;
+        Secret_t fSecret;
+        std::array<std::byte, PendingCapacity> fPending;
+        uint64_t fSeed;
+        uint64_t fTotalLength;
+        size_t fPendingSize;
+        size_t fStripesInBlock;
+    };
+
+    using XXHash3_64 = XXHash3Base<64>;
+    using XXHash3_128 = XXHash3Base<128>;
+
+
+    // CRC-32C (Castagnoli), using the SSE4.2 / ARMv8 CRC instructions when the CPU supports them
+    // and a slicing-by-8 table implementation otherwise.
+    // Streaming: construct, Update() any number of times, Digest().
+    class CRC32C
+    {
+    public:
+        using Seed_t = uint32_t;
+        using Inputs = HashInputs<CRC32C>;
+
+        enum class Method
+        {
+              Table
+            , SSE42
+            , ARMv8
+        };
+
+        // 'initial' is a previous Digest() to continue from.
+        CRC32C(uint32_t initial = 0) : fState(~initial)
+        {
+
+        }
+
+        void Update(const void* data, size_t size)
+        {
+            fState = GetUpdateFunction()(fState, static_cast<const std::byte*>(data), size);
+        }
+
+        void Update(std::span<const std::byte> data)
+        {
+            Update(data.data(), data.size());
+        }
+
+        uint32_t Digest() const
+        {
+            return ~fState;
+        }
+
+        static uint32_t Compute(const void* data, size_t size, uint32_t initial = 0)
+        {
+            CRC32C crc(initial);
+            crc.Update(data, size);
+            return crc.Digest();
+        }
+
+        static Method GetMethod()
+        {
+            static const Method sMethod = DetectMethod();
+            return sMethod;
+        }
+
+    private:
+        using UpdateFunction = uint32_t(*)(uint32_t, const std::byte*, size_t);
+        static constexpr uint32_t Polynomial = 0x82F63B78; // reflected
+
+        static Method DetectMethod()
+        {
+#if LLUTILS_HASH_X64
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("sse4.2"))
+                return Method::SSE42;
+    #elif LLUTILS_COMPILER == LLUTILS_COMPILER_MSVC
+            int info[4];
+            __cpuid(info, 1);
+            if ((info[2] & (1 << 20)) != 0)
+                return Method::SSE42;
+    #endif
+#elif LLUTILS_HASH_ARM64 && LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            if ((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0)
+                return Method::ARMv8;
+#endif
+            return Method::Table;
+        }
+
+        static UpdateFunction GetUpdateFunction()
+        {
+            static const UpdateFunction sUpdate = []() -> UpdateFunction
+            {
+                switch (GetMethod())
+                {
+#if LLUTILS_HASH_X64
+                case Method::SSE42:
+                    return &UpdateSSE42;
+#endif
+#if LLUTILS_HASH_ARM64
+                case Method::ARMv8:
+                    return &UpdateARMv8;
+#endif
+                default:
+                    return &UpdateTable;
+                }
+            }();
+            return sUpdate;
+        }
+
+        using Table_t = std::array<std::array<uint32_t, 256>, 8>;
+
+        static constexpr Table_t MakeTable()
+        {
+            Table_t table{};
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++)
+                    crc = (crc >> 1) ^ ((crc & 1) != 0 ? Polynomial : 0);
+                table[0][i] = crc;
+            }
+
+            for (uint32_t i = 0; i < 256; i++)
+                for (size_t slice = 1; slice < 8; slice++)
+                    table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+
+            return table;
+        }
+
+        static uint32_t UpdateTable(uint32_t crc, const std::byte* data, size_t size)
+        {
+            static constexpr Table_t sTable = MakeTable();
+            while (size >= 8)
+            {
+                const uint32_t low = Endian::Load<uint32_t>(data) ^ crc;
+                const uint32_t high = Endian::Load<uint32_t>(data + 4);
+                crc = sTable[7][low & 0xFF] ^ sTable[6][(low >> 8) & 0xFF] ^ sTable[5][(low >> 16) & 0xFF] ^ sTable[4][low >> 24]
+                    ^ sTable[3][high & 0xFF] ^ sTable[2][(high >> 8) & 0xFF] ^ sTable[1][(high >> 16) & 0xFF] ^ sTable[0][high >> 24];
+                data += 8;
+                size -= 8;
+            }
+
+            while (size-- > 0)
+                crc = (crc >> 8) ^ sTable[0][(crc ^ static_cast<uint8_t>(*data++)) & 0xFF];
+
+            return crc;
+        }
+
+#if LLUTILS_HASH_X64
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+        __attribute__((target("sse4.2")))
+    #endif
+        static uint32_t UpdateSSE42(uint32_t crc, const std::byte* data, size_t size)
+        {
+            uint64_t crc64 = crc;
+            while (size >= 8)
+            {
+                crc64 = _mm_crc32_u64(crc64, Endian::Load<uint64_t>(data));
+                data += 8;
+                size -= 8;
+            }
+
+            crc = static_cast<uint32_t>(crc64);
+            while (size-- > 0)
+                crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data++));
+            return crc;
+        }
+#endif
+
+#if LLUTILS_HASH_ARM64
+        __attribute__((target("+crc")))
+        static uint32_t UpdateARMv8(uint32_t crc, const std::byte* data, size_t size)
+        {
+            while (size >= 8)
+            {
+                crc = __crc32cd(crc, Endian::Load<uint64_t>(data));
+                data += 8;
+                size -= 8;
+            }
+
+            while (size-- > 0)
+                crc = __crc32cb(crc, static_cast<uint8_t>(*data++));
+            return crc;
+        }
+#endif
+
+        uint32_t fState;
+    };
+}
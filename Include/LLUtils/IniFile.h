@@ -17,23 +17,42 @@ namespace LLUtils
         	if (std::filesystem::exists(fileName) == false || std::filesystem::is_regular_file(fileName) == false)
                 LL_EXCEPTION(LLUtils::Exception::ErrorCode::NotFound, "The file: '"s + StringUtility::ToAString(fileName) + "' has not been found or it's not a regular file"s);
 
-            std::string fileContents = File::ReadAllText(fileName);
-            ListAString lines = StringUtility::split(fileContents, '\n');
-
-            for (const std::string& pair : lines)
+            File::ForEachLine(fileName, [this](std::string_view pair)
             {
+                // Trailing nulls are dropped, as split used to.
+                auto trimNulls = [](std::string_view& text)
+                {
+                    while (text.empty() == false && text.back() == '\0')
+                        text.remove_suffix(1);
+                };
+
+                trimNulls(pair);
                 if (pair.length() > 0 && pair[0] == ';')
-                    continue;
-                ListAString pairSplitted = StringUtility::split(pair, '=');
-                if (pairSplitted.size() != 2)
-                    continue;
-                std::string key = pairSplitted[0];
+                    return;
+
+                // Exactly two non empty parts separated by '='.
+                std::string_view parts[2];
+                size_t partCount = 0;
+                for (size_t start = 0; start <= pair.length();)
+                {
+                    const size_t end = (std::min)(pair.find('=', start), pair.length());
+                    if (end > start && partCount++ < 2)
+                        parts[partCount - 1] = pair.substr(start, end - start);
+                    start = end + 1;
+                }
+                if (partCount != 2)
+                    return;
+
+                trimNulls(parts[0]);
+                trimNulls(parts[1]);
+
+                std::string key(parts[0]);
                 StringUtility::trim(key, "\t\n\r ");
                 key = StringUtility::ToLower(key);
-                std::string value = pairSplitted[1];
+                std::string value(parts[1]);
                 StringUtility::trim(value, "\t\n\r ");
                 mSettings[key] = value;
-            }
+            });
         }
 
         const std::string& GetEntry(const std::string& key, bool throwifNotFound = true) const
@@ -0,0 +1,619 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Endian.h>
+#include <LLUtils/Hash.h>
+
+namespace LLUtils
+{
+    // Dependency free LZ77 codec producing the LZ4 block format, so blocks are interchangeable with liblz4.
+    class LZCodec
+    {
+    public:
+        // Worst case compressed size of a block.
+        static constexpr size_t CompressBound(size_t size)
+        {
+            return size + size / 255 + 16;
+        }
+
+        // Returns the compressed size, dstCapacity must be at least CompressBound(srcSize).
+        static size_t CompressBlock(const std::byte* src, size_t srcSize, std::byte* dst, size_t dstCapacity)
+        {
+            if (dstCapacity < CompressBound(srcSize))
+                throw std::runtime_error("Destination buffer too small");
+
+            if (srcSize > MaxBlockInput)
+                throw std::runtime_error("Block too large");
+
+            thread_local std::array<uint32_t, HashTableSize> sHashTable;
+            std::array<uint32_t, HashTableSize>& table = sHashTable;
+
+            const std::byte* ip = src;
+            const std::byte* anchor = src;
+            const std::byte* const iend = src + srcSize;
+            std::byte* op = dst;
+
+            if (srcSize >= MinInputSize)
+            {
+                const std::byte* const mflimit = iend - MFLimit;
+                const std::byte* const matchlimit = iend - LastLiterals;
+
+                table.fill(0);
+                table[Hash(ip)] = 0;
+                ip++;
+
+                for (;;)
+                {
+                    // Find a match, skipping faster through incompressible data.
+                    const std::byte* match;
+                    size_t attempts = 1 << SkipStrength;
+                    for (;;)
+                    {
+                        const uint32_t h = Hash(ip);
+                        match = src + table[h];
+                        table[h] = static_cast<uint32_t>(ip - src);
+                        if (ip - match <= MaxOffset && Read32(match) == Read32(ip))
+                            break;
+
+                        ip += attempts++ >> SkipStrength;
+                        if (ip > mflimit)
+                            goto lastLiterals;
+                    }
+
+                    while (ip > anchor && match > src && ip[-1] == match[-1])
+                    {
+                        ip--;
+                        match--;
+                    }
+
+                    const size_t literalLength = static_cast<size_t>(ip - anchor);
+                    std::byte* token = op++;
+                    op = WriteLength(op, token, literalLength, 4);
+                    memcpy(op, anchor, literalLength);
+                    op += literalLength;
+
+                    const uint16_t offset = static_cast<uint16_t>(ip - match);
+                    const size_t matchLength = CountMatch(ip + MinMatch, match + MinMatch, matchlimit);
+                    Endian::Store<uint16_t>(op, offset);
+                    op += 2;
+                    op = WriteLength(op, token, matchLength, 0);
+
+                    ip += MinMatch + matchLength;
+                    anchor = ip;
+                    if (ip > mflimit)
+                        break;
+
+                    table[Hash(ip - 2)] = static_cast<uint32_t>(ip - 2 - src);
+                }
+            }
+
+        lastLiterals:
+            const size_t literalLength = static_cast<size_t>(iend - anchor);
+            std::byte* token = op++;
+            op = WriteLength(op, token, literalLength, 4);
+            if (literalLength > 0)
+                memcpy(op, anchor, literalLength);
+            op += literalLength;
+            return static_cast<size_t>(op - dst);
+        }
+
+        // Returns the decompressed size. Malformed input throws, it never reads or writes out of bounds.
+        static size_t DecompressBlock(const std::byte* src, size_t srcSize, std::byte* dst, size_t dstCapacity)
+        {
+            const std::byte* ip = src;
+            const std::byte* const iend = src + srcSize;
+            std::byte* op = dst;
+            std::byte* const oend = dst + dstCapacity;
+
+            if (srcSize == 0)
+                throw std::runtime_error("Corrupted compressed block");
+
+            for (;;)
+            {
+                const uint8_t token = static_cast<uint8_t>(*ip++);
+
+                size_t literalLength = token >> 4;
+
+                // Fast path for short sequences: both lengths fit in the token and there is room to over-copy fixed sizes.
+                if (literalLength < 15 && (token & 15) < 15 && iend - ip >= 16 + 2 && oend - op >= 16 + 18)
+                {
+                    memcpy(op, ip, 16);
+                    op += literalLength;
+                    ip += literalLength;
+
+                    const size_t offset = Endian::Load<uint16_t>(ip);
+                    ip += 2;
+                    if (offset >= 8 && offset <= static_cast<size_t>(op - dst))
+                    {
+                        const std::byte* match = op - offset;
+                        memcpy(op, match, 8);
+                        memcpy(op + 8, match + 8, 8);
+                        memcpy(op + 16, match + 16, 2);
+                        op += (token & 15) + MinMatch;
+                        continue;
+                    }
+
+                    // Overlapping or invalid match, let the general path handle it.
+                    ip -= 2;
+                    literalLength = 0;
+                }
+
+                if (literalLength == 15)
+                    literalLength += ReadLength(ip, iend);
+
+                if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op))
+                    throw std::runtime_error("Corrupted compressed block");
+
+                if (literalLength <= 16 && iend - ip >= 16 && oend - op >= 16)
+                    memcpy(op, ip, 16);
+                else
+                    memcpy(op, ip, literalLength);
+                op += literalLength;
+                ip += literalLength;
+
+                if (ip == iend)
+                    break;
+
+                if (iend - ip < 2)
+                    throw std::runtime_error("Corrupted compressed block");
+
+                const size_t offset = Endian::Load<uint16_t>(ip);
+                ip += 2;
+                if (offset == 0 || offset > static_cast<size_t>(op - dst))
+                    throw std::runtime_error("Corrupted compressed block");
+
+                size_t matchLength = token & 15;
+                if (matchLength == 15)
+                    matchLength += ReadLength(ip, iend);
+                matchLength += MinMatch;
+
+                if (matchLength > static_cast<size_t>(oend - op))
+                    throw std::runtime_error("Corrupted compressed block");
+
+                CopyMatch(op, op - offset, matchLength, oend);
+                op += matchLength;
+
+                if (ip >= iend)
+                    throw std::runtime_error("Corrupted compressed block");
+            }
+
+            return static_cast<size_t>(op - dst);
+        }
+
+        template <typename BufferType = Buffer>
+        static BufferType Compress(std::span<const std::byte> data)
+        {
+            BufferType compressed(CompressBound(data.size()));
+            compressed.Resize(CompressBlock(data.data(), data.size(), compressed.data(), compressed.size()));
+            return compressed;
+        }
+
+        // The block format doesn't store the original size, it has to be provided by the caller.
+        template <typename BufferType = Buffer>
+        static BufferType Decompress(std::span<const std::byte> data, size_t decompressedSize)
+        {
+            BufferType decompressed(decompressedSize);
+            if (DecompressBlock(data.data(), data.size(), decompressed.data(), decompressed.size()) != decompressedSize)
+                throw std::runtime_error("Corrupted compressed block");
+            return decompressed;
+        }
+
+    private:
+        static constexpr size_t MinMatch = 4;
+        static constexpr size_t LastLiterals = 5;
+        static constexpr size_t MFLimit = 12;
+        static constexpr size_t MinInputSize = MFLimit + 1;
+        static constexpr ptrdiff_t MaxOffset = 65535;
+        static constexpr size_t MaxBlockInput = 0x7E000000;
+        static constexpr unsigned HashLog = 14;
+        static constexpr size_t HashTableSize = size_t{ 1 } << HashLog;
+        static constexpr unsigned SkipStrength = 6;
+
+        static uint32_t Read32(const std::byte* p)
+        {
+            uint32_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        static uint32_t Hash(const std::byte* p)
+        {
+            return (Read32(p) * 2654435761U) >> (32 - HashLog);
+        }
+
+        // Number of equal bytes following ip and match, not reaching past limit.
+        static size_t CountMatch(const std::byte* ip, const std::byte* match, const std::byte* limit)
+        {
+            const std::byte* const start = ip;
+            while (limit - ip >= 8)
+            {
+                uint64_t a, b;
+                memcpy(&a, ip, 8);
+                memcpy(&b, match, 8);
+                const uint64_t diff = a ^ b;
+                if (diff != 0)
+                {
+                    const int equalBits = Endian::IsLittleEndian ? std::countr_zero(diff) : std::countl_zero(diff);
+                    return static_cast<size_t>(ip - start) + static_cast<size_t>(equalBits / 8);
+                }
+                ip += 8;
+                match += 8;
+            }
+
+            while (ip < limit && *ip == *match)
+            {
+                ip++;
+                match++;
+            }
+            return static_cast<size_t>(ip - start);
+        }
+
+        // Writes the 4 bit token nibble at 'shift' and any extra length bytes.
+        static std::byte* WriteLength(std::byte* op, std::byte* token, size_t length, int shift)
+        {
+            const uint8_t previous = shift == 4 ? 0 : static_cast<uint8_t>(*token);
+            if (length < 15)
+            {
+                *token = static_cast<std::byte>(previous | (length << shift));
+                return op;
+            }
+
+            *token = static_cast<std::byte>(previous | (15 << shift));
+            length -= 15;
+            while (length >= 255)
+            {
+                *op++ = std::byte{ 255 };
+                length -= 255;
+            }
+            *op++ = static_cast<std::byte>(length);
+            return op;
+        }
+
+        static size_t ReadLength(const std::byte*& ip, const std::byte* iend)
+        {
+            size_t length = 0;
+            uint8_t value;
+            do
+            {
+                if (ip >= iend)
+                    throw std::runtime_error("Corrupted compressed block");
+                value = static_cast<uint8_t>(*ip++);
+                length += value;
+            } while (value == 255);
+            return length;
+        }
+
+        static void CopyMatch(std::byte* op, const std::byte* match, size_t length, const std::byte* oend)
+        {
+            const size_t offset = static_cast<size_t>(op - match);
+            if (offset >= 16 && static_cast<size_t>(oend - op) >= length + 16)
+            {
+                // Chunks never overlap within a copy, later chunks read bytes already written.
+                for (size_t i = 0; i < length; i += 16)
+                    memcpy(op + i, match + i, 16);
+            }
+            else if (offset >= 8 && static_cast<size_t>(oend - op) >= length + 8)
+            {
+                for (size_t i = 0; i < length; i += 8)
+                    memcpy(op + i, match + i, 8);
+            }
+            else if (offset >= length)
+            {
+                memcpy(op, match, length);
+            }
+            else
+            {
+                for (size_t i = 0; i < length; i++)
+                    op[i] = match[i];
+            }
+        }
+    };
+
+
+    // Streaming frame format on top of LZCodec blocks:
+    //   uint32 magic, uint32 block size
+    //   blocks: uint32 size (high bit set = stored uncompressed), payload
+    //   uint32 0 end mark, uint64 XXH64 of the uncompressed content
+    // All integers are little endian.
+    template <typename BufferType = Buffer>
+    class LZFrameBase
+    {
+    public:
+        static constexpr uint32_t Magic = 0x315A4C4C; // "LLZ1"
+        static constexpr size_t DefaultBlockSize = 256 * 1024;
+
+        class Encoder
+        {
+        public:
+            Encoder(size_t blockSize = DefaultBlockSize) : fBlockSize(blockSize), fBlock(blockSize), fScratch(LZCodec::CompressBound(blockSize))
+            {
+                if (blockSize == 0 || blockSize > MaxBlockSize)
+                    throw std::runtime_error("Invalid block size");
+
+                AppendUInt32(Magic);
+                AppendUInt32(static_cast<uint32_t>(blockSize));
+            }
+
+            void Update(const std::byte* data, size_t size)
+            {
+                fHash.Update(data, size);
+                while (size > 0)
+                {
+                    const size_t length = (std::min)(size, fBlockSize - fBlockFill);
+                    memcpy(fBlock.data() + fBlockFill, data, length);
+                    fBlockFill += length;
+                    data += length;
+                    size -= length;
+                    if (fBlockFill == fBlockSize)
+                        FlushBlock();
+                }
+            }
+
+            void Update(std::span<const std::byte> data)
+            {
+                Update(data.data(), data.size());
+            }
+
+            // Compressed bytes produced so far, may be drained with TakeOutput between updates.
+            BufferType TakeOutput()
+            {
+                BufferType output = std::move(fOutput);
+                fOutput = BufferType();
+                return output;
+            }
+
+            // Flush the last block, write the trailer and return the remaining output.
+            BufferType Finish()
+            {
+                FlushBlock();
+                AppendUInt32(0);
+                uint8_t digest[8];
+                Endian::Store<uint64_t>(digest, fHash.Digest());
+                fOutput.Append(reinterpret_cast<const std::byte*>(digest), sizeof(digest));
+                return TakeOutput();
+            }
+
+        private:
+            void FlushBlock()
+            {
+                if (fBlockFill == 0)
+                    return;
+
+                const size_t compressedSize = LZCodec::CompressBlock(fBlock.data(), fBlockFill, fScratch.data(), fScratch.size());
+                if (compressedSize < fBlockFill)
+                {
+                    AppendUInt32(static_cast<uint32_t>(compressedSize));
+                    fOutput.Append(fScratch.data(), compressedSize);
+                }
+                else
+                {
+                    AppendUInt32(static_cast<uint32_t>(fBlockFill) | UncompressedFlag);
+                    fOutput.Append(fBlock.data(), fBlockFill);
+                }
+                fBlockFill = 0;
+            }
+
+            void AppendUInt32(uint32_t value)
+            {
+                std::byte bytes[4];
+                Endian::Store<uint32_t>(bytes, value);
+                fOutput.Append(bytes, sizeof(bytes));
+            }
+
+            size_t fBlockSize;
+            size_t fBlockFill = 0;
+            BufferType fBlock;
+            BufferType fScratch;
+            BufferType fOutput;
+            XXHash64 fHash;
+        };
+
+
+        // Accepts compressed input in arbitrary chunks and hands each decompressed block to a callback.
+        // Complete blocks are decoded straight from the input, only a block split across calls is buffered.
+        class Decoder
+        {
+        public:
+            using OnData = std::function<void(std::span<const std::byte>)>;
+
+            Decoder(OnData onData) : fOnData(std::move(onData))
+            {
+
+            }
+
+            void Update(const std::byte* data, size_t size)
+            {
+                if (fState == State::Finished)
+                    return;
+
+                // Complete the unit left over from the previous call, taking no more input than it needs.
+                while (fPending.size() > 0 && size > 0)
+                {
+                    const size_t needed = GetUnitSize(fPending.data(), fPending.size()) - fPending.size();
+                    const size_t length = (std::min)(size, needed);
+                    fPending.Append(data, length);
+                    data += length;
+                    size -= length;
+
+                    size_t position = 0;
+                    if (Step(fPending.data(), fPending.size(), position))
+                        fPending.Resize(0);
+                }
+
+                size_t position = 0;
+                while (Step(data, size, position))
+                {
+                }
+
+                if (position < size && fState != State::Finished)
+                    fPending.Append(data + position, size - position);
+            }
+
+            void Update(std::span<const std::byte> data)
+            {
+                Update(data.data(), data.size());
+            }
+
+            // True once the trailer has been read and the checksum verified.
+            bool IsFinished() const
+            {
+                return fState == State::Finished;
+            }
+
+        private:
+            enum class State
+            {
+                  Header
+                , Blocks
+                , Checksum
+                , Finished
+            };
+
+            // Size of the next unit (header, block or checksum), as far as it can be told from the available bytes.
+            size_t GetUnitSize(const std::byte* p, size_t available) const
+            {
+                switch (fState)
+                {
+                case State::Blocks:
+                    return available < 4 ? 4 : 4 + (Endian::Load<uint32_t>(p) & ~UncompressedFlag);
+                case State::Finished:
+                    return 0;
+                default:
+                    return 8;
+                }
+            }
+
+            // Consumes one unit at data + position, returns false if it isn't complete yet.
+            bool Step(const std::byte* data, size_t size, size_t& position)
+            {
+                const size_t available = size - position;
+                const std::byte* p = data + position;
+                switch (fState)
+                {
+                case State::Header:
+                    if (available < 8)
+                        return false;
+                    if (Endian::Load<uint32_t>(p) != Magic)
+                        throw std::runtime_error("Not an LZ frame");
+                    fBlockSize = Endian::Load<uint32_t>(p + 4);
+                    if (fBlockSize == 0 || fBlockSize > MaxBlockSize)
+                        throw std::runtime_error("Invalid block size");
+                    fBlock.Allocate(fBlockSize);
+                    position += 8;
+                    fState = State::Blocks;
+                    return true;
+
+                case State::Blocks:
+                {
+                    if (available < 4)
+                        return false;
+                    const uint32_t header = Endian::Load<uint32_t>(p);
+                    if (header == 0)
+                    {
+                        position += 4;
+                        fState = State::Checksum;
+                        return true;
+                    }
+
+                    const size_t payloadSize = header & ~UncompressedFlag;
+                    if (payloadSize > LZCodec::CompressBound(fBlockSize))
+                        throw std::runtime_error("Corrupted LZ frame");
+                    if (available < 4 + payloadSize)
+                        return false;
+
+                    std::span<const std::byte> block;
+                    if ((header & UncompressedFlag) != 0)
+                    {
+                        if (payloadSize > fBlockSize)
+                            throw std::runtime_error("Corrupted LZ frame");
+                        block = std::span<const std::byte>(p + 4, payloadSize);
+                    }
+                    else
+                    {
+                        const size_t size = LZCodec::DecompressBlock(p + 4, payloadSize, fBlock.data(), fBlockSize);
+                        block = std::span<const std::byte>(fBlock.data(), size);
+                    }
+
+                    position += 4 + payloadSize;
+                    fHash.Update(block);
+                    fOnData(block);
+                    return true;
+                }
+
+                case State::Checksum:
+                    if (available < 8)
+                        return false;
+                    if (Endian::Load<uint64_t>(p) != fHash.Digest())
+                        throw std::runtime_error("LZ frame checksum mismatch");
+                    position += 8;
+                    fState = State::Finished;
+                    return true;
+
+                case State::Finished:
+                    return false;
+                }
+                return false;
+            }
+
+            OnData fOnData;
+            State fState = State::Header;
+            size_t fBlockSize = 0;
+            BufferType fBlock;
+            BufferType fPending;
+            XXHash64 fHash;
+        };
+
+        static BufferType Compress(std::span<const std::byte> data, size_t blockSize = DefaultBlockSize)
+        {
+            Encoder encoder(blockSize);
+            encoder.Update(data);
+            return encoder.Finish();
+        }
+
+        static BufferType Decompress(std::span<const std::byte> frame)
+        {
+            BufferType output;
+            Decoder decoder([&output](std::span<const std::byte> block) { output.Append(block.data(), block.size()); });
+            decoder.Update(frame);
+            if (decoder.IsFinished() == false)
+                throw std::runtime_error("Truncated LZ frame");
+            return output;
+        }
+
+    private:
+        static constexpr uint32_t UncompressedFlag = 0x80000000;
+        static constexpr size_t MaxBlockSize = 64 * 1024 * 1024;
+    };
+
+    using LZFrame = LZFrameBase<>;
+}
@@ -0,0 +1,226 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <LLUtils/Platform.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define LLUTILS_LINE_READER_X64 1
+    #include <immintrin.h>
+#else
+    #define LLUTILS_LINE_READER_X64 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define LLUTILS_LINE_READER_NEON 1
+    #include <arm_neon.h>
+#else
+    #define LLUTILS_LINE_READER_NEON 0
+#endif
+
+namespace LLUtils
+{
+    // Splits text in memory into lines without copying, lines are views into the text.
+    // Lines end with '\n', a trailing '\r' is removed, the last line may end without a line break.
+    //
+    //  LineReader reader(text);
+    //  for (std::string_view line; reader.Next(line);)
+    //      Process(line);
+    class LineReader
+    {
+    public:
+        enum class Method
+        {
+              Scalar    // memchr
+            , SSE2
+            , AVX2
+            , NEON
+        };
+
+        LineReader(std::string_view text) : fPosition(text.data()), fEnd(text.data() + text.size())
+        {
+
+        }
+
+        bool Next(std::string_view& line)
+        {
+            if (fPosition == fEnd)
+                return false;
+
+            const char* newLine = FindNewLine(fPosition, fEnd);
+            const char* lineEnd = newLine;
+            if (lineEnd != fPosition && lineEnd[-1] == '\r')
+                lineEnd--;
+
+            line = std::string_view(fPosition, static_cast<size_t>(lineEnd - fPosition));
+            fPosition = newLine == fEnd ? fEnd : newLine + 1;
+            return true;
+        }
+
+        // The text following the last line returned.
+        std::string_view GetRemaining() const
+        {
+            return std::string_view(fPosition, static_cast<size_t>(fEnd - fPosition));
+        }
+
+        // Invoke 'func(std::string_view line)' for each line, return false from 'func' to stop early.
+        // Returns false if stopped early.
+        template <typename Func>
+        static bool ForEachLine(std::string_view text, Func&& func)
+        {
+            LineReader reader(text);
+            for (std::string_view line; reader.Next(line);)
+            {
+                if constexpr (std::is_same_v<decltype(func(line)), bool>)
+                {
+                    if (func(line) == false)
+                        return false;
+                }
+                else
+                {
+                    func(line);
+                }
+            }
+            return true;
+        }
+
+        // Position of the first '\n' in [begin, end), or end if there is none.
+        static const char* FindNewLine(const char* begin, const char* end)
+        {
+            static const FindFunction sFind = GetFindFunction();
+            return sFind(begin, end);
+        }
+
+        static Method GetMethod()
+        {
+            static const Method sMethod = DetectMethod();
+            return sMethod;
+        }
+
+    private:
+        using FindFunction = const char* (*)(const char*, const char*);
+
+        static Method DetectMethod()
+        {
+#if LLUTILS_LINE_READER_X64
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return Method::AVX2;
+    #endif
+            return Method::SSE2;
+#elif LLUTILS_LINE_READER_NEON
+            return Method::NEON;
+#else
+            return Method::Scalar;
+#endif
+        }
+
+        static FindFunction GetFindFunction()
+        {
+            switch (GetMethod())
+            {
+#if LLUTILS_LINE_READER_X64
+            case Method::AVX2:
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+                return &FindAVX2;
+    #endif
+            case Method::SSE2:
+                return &FindSSE2;
+#endif
+#if LLUTILS_LINE_READER_NEON
+            case Method::NEON:
+                return &FindNEON;
+#endif
+            default:
+                return &FindScalar;
+            }
+        }
+
+        static const char* FindScalar(const char* begin, const char* end)
+        {
+            const void* found = memchr(begin, '\n', static_cast<size_t>(end - begin));
+            return found != nullptr ? static_cast<const char*>(found) : end;
+        }
+
+#if LLUTILS_LINE_READER_X64
+        static const char* FindSSE2(const char* begin, const char* end)
+        {
+            const __m128i newLine = _mm_set1_epi8('\n');
+            for (; end - begin >= 16; begin += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newLine)));
+                if (mask != 0)
+                    return begin + std::countr_zero(mask);
+            }
+            return FindScalar(begin, end);
+        }
+
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+        __attribute__((target("avx2")))
+        static const char* FindAVX2(const char* begin, const char* end)
+        {
+            const __m256i newLine = _mm256_set1_epi8('\n');
+            // Two vectors per iteration, lines are usually longer than 32 bytes.
+            for (; end - begin >= 64; begin += 64)
+            {
+                const __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)), newLine);
+                const __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 32)), newLine);
+                if (_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b)) == 0)
+                {
+                    const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(a)) | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(b))) << 32);
+                    return begin + std::countr_zero(mask);
+                }
+            }
+            return FindSSE2(begin, end);
+        }
+    #endif
+#endif
+
+#if LLUTILS_LINE_READER_NEON
+        static const char* FindNEON(const char* begin, const char* end)
+        {
+            const uint8x16_t newLine = vdupq_n_u8('\n');
+            for (; end - begin >= 16; begin += 16)
+            {
+                const uint8x16_t equal = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(begin)), newLine);
+                // Narrow each byte of the comparison to 4 bits, giving a 64 bit mask.
+                const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+                if (mask != 0)
+                    return begin + std::countr_zero(mask) / 4;
+            }
+            return FindScalar(begin, end);
+        }
+#endif
+
+    private:
+        const char* fPosition;
+        const char* fEnd;
+    };
+}
@@ -23,6 +23,7 @@ SOFTWARE.
 #pragma once
 #include "LogTarget.h"
 #include <LLUtils/FileHelper.h>
+#include <LLUtils/FileWriter.h>
 #include "../FileSystemHelper.h"
 #include <iostream>
 namespace LLUtils
@@ -52,12 +53,16 @@ namespace LLUtils
 			FileSystemHelper::EnsureDirectory(mLogPath);
 			if (clear == true)
 				std::filesystem::remove(logPath);
+
+			// Unbuffered so every message reaches the file even if the process crashes, the file is only opened once.
+			if (mLogPath.empty() == false)
+				mWriter = std::make_unique<FileWriter>(std::filesystem::path(mLogPath).native(), FileWriter::Options{ .bufferSize = 0 });
 		}
 		void Log(std::wstring message) override
 		{
-			if (mLogPath.empty() == false)
+			if (mWriter != nullptr)
 			{
-				File::WriteAllText(mLogPath, message, true);
+				mWriter->Write(StringUtility::ToAString(message));
 			}
 		}
 
@@ -69,5 +74,6 @@ namespace LLUtils
 
 	private:
 		std::wstring mLogPath;
+		std::unique_ptr<FileWriter> mWriter;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <LLUtils/Buffer.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+    #include <Windows.h>
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace LLUtils
+{
+    // Allocator policy for large buffers, backed directly by anonymous memory mappings.
+    // Memory is returned to the OS as soon as the buffer is freed.
+    // Populate   - pre-fault the pages on allocation and growth (MAP_POPULATE / MADV_POPULATE_WRITE).
+    // HugePages  - request transparent huge pages (MADV_HUGEPAGE) to reduce TLB misses.
+    // Data starts at the beginning of the mapping, mapping lengths are kept in a process-wide table.
+    template <bool Populate = false, bool HugePages = true>
+    class MMapAllocBase
+    {
+    public:
+        static constexpr int Alignment = 4096;
+
+        static std::byte* Allocate(size_t size)
+        {
+            const size_t length = GetMappingLength(size);
+            std::byte* base = Map(length);
+            try
+            {
+                GetMappingTable().Insert(base, length);
+            }
+            catch (...)
+            {
+                Unmap(base, length);
+                throw;
+            }
+            return base;
+        }
+
+        static void Deallocate(std::byte* buffer)
+        {
+            if (buffer == nullptr)
+                return;
+
+            Unmap(buffer, GetMappingTable().Remove(buffer));
+        }
+
+        static std::byte* Reallocate(std::byte* buffer, [[maybe_unused]] size_t oldSize, size_t newSize)
+        {
+            if (buffer == nullptr)
+                return Allocate(newSize);
+
+            MappingTable& table = GetMappingTable();
+            const size_t oldLength = table.Find(buffer);
+            const size_t newLength = GetMappingLength(newSize);
+            if (newLength == oldLength)
+                return buffer;
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            // Let the kernel move the page table entries instead of copying the data.
+            void* remapped = mremap(buffer, oldLength, newLength, MREMAP_MAYMOVE);
+            if (remapped == MAP_FAILED)
+                throw std::bad_alloc();
+
+            std::byte* newBase = reinterpret_cast<std::byte*>(remapped);
+            table.Replace(buffer, newBase, newLength);
+            if (newLength > oldLength)
+            {
+                Advise(newBase, newLength);
+                if constexpr (Populate)
+                    Prefault(newBase + oldLength, newLength - oldLength);
+            }
+            return newBase;
+#else
+            std::byte* newBuffer = Allocate(newSize);
+            memcpy(newBuffer, buffer, (std::min)(oldSize, newSize));
+            Deallocate(buffer);
+            return newBuffer;
+#endif
+        }
+
+    private:
+        // Mapping lengths by base address. Mapped allocations are large and few, a single lock is cheap next to mmap.
+        class MappingTable
+        {
+        public:
+            void Insert(std::byte* base, size_t length)
+            {
+                std::lock_guard lock(fMutex);
+                fLengths.emplace(base, length);
+            }
+
+            size_t Find(std::byte* base)
+            {
+                std::lock_guard lock(fMutex);
+                return fLengths.at(base);
+            }
+
+            size_t Remove(std::byte* base)
+            {
+                std::lock_guard lock(fMutex);
+                auto it = fLengths.find(base);
+                const size_t length = it->second;
+                fLengths.erase(it);
+                return length;
+            }
+
+            void Replace(std::byte* oldBase, std::byte* newBase, size_t length)
+            {
+                std::lock_guard lock(fMutex);
+                fLengths.erase(oldBase);
+                fLengths[newBase] = length;
+            }
+
+        private:
+            std::mutex fMutex;
+            std::unordered_map<std::byte*, size_t> fLengths;
+        };
+
+        static MappingTable& GetMappingTable()
+        {
+            // Intentionally leaked, buffers may be freed during static destruction.
+            static MappingTable* sTable = new MappingTable();
+            return *sTable;
+        }
+
+        static size_t GetMappingLength(size_t size)
+        {
+            return LLUtils::Utility::Align<size_t>((std::max)(size, size_t{ 1 }), GetPageSize());
+        }
+
+        static size_t GetPageSize()
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            static const size_t sPageSize = []
+            {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<size_t>(info.dwPageSize);
+            }();
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            static const size_t sPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            return sPageSize;
+        }
+
+        static std::byte* Map(size_t length)
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            void* base = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            if (base == nullptr)
+                throw std::bad_alloc();
+            return reinterpret_cast<std::byte*>(base);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+            // With huge pages the pages are populated after madvise, so they can be backed by huge pages from the start.
+            if constexpr (Populate && HugePages == false)
+                flags |= MAP_POPULATE;
+
+            void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (base == MAP_FAILED)
+                throw std::bad_alloc();
+
+            Advise(reinterpret_cast<std::byte*>(base), length);
+            if constexpr (Populate && HugePages)
+                Prefault(reinterpret_cast<std::byte*>(base), length);
+            return reinterpret_cast<std::byte*>(base);
+#endif
+        }
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+        static void Advise([[maybe_unused]] std::byte* base, [[maybe_unused]] size_t length)
+        {
+#ifdef MADV_HUGEPAGE
+            // Best effort, THP may be disabled system wide.
+            if constexpr (HugePages)
+                madvise(base, length, MADV_HUGEPAGE);
+#endif
+        }
+
+        static void Prefault(std::byte* base, size_t length)
+        {
+#ifdef MADV_POPULATE_WRITE
+            if (madvise(base, length, MADV_POPULATE_WRITE) == 0)
+                return;
+#endif
+            const size_t pageSize = GetPageSize();
+            for (size_t offset = 0; offset < length; offset += pageSize)
+                reinterpret_cast<volatile std::byte*>(base)[offset] = std::byte{ 0 };
+        }
+#endif
+
+        static void Unmap(std::byte* base, [[maybe_unused]] size_t length)
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_WIN32
+            VirtualFree(base, 0, MEM_RELEASE);
+#elif LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            munmap(base, length);
+#endif
+        }
+    };
+
+    using MMapAlloc = MMapAllocBase<>;
+    using MMapPopulateAlloc = MMapAllocBase<true>;
+
+
+    // Routes allocations to SmallAlloc or LargeAlloc depending on the requested size.
+    // A small tag right before each buffer records which allocator owns it. Large blocks reserve a header
+    // of LargeAlloc's alignment so their data keeps that alignment, e.g. page aligned with MMapAlloc.
+    template <typename SmallAlloc = AlignedAlloc, typename LargeAlloc = MMapAlloc, size_t Threshold = 4 * 1024 * 1024>
+    class HybridAlloc
+    {
+    public:
+        static constexpr int Alignment = static_cast<int>((std::min)(GetAllocatorAlignment<SmallAlloc>(), GetAllocatorAlignment<LargeAlloc>()));
+
+        static std::byte* Allocate(size_t size)
+        {
+            const bool large = size >= Threshold;
+            const size_t headerSize = GetHeaderSize(large);
+            std::byte* block = large ? LargeAlloc::Allocate(size + headerSize) : SmallAlloc::Allocate(size + headerSize);
+            if (block == nullptr)
+                throw std::bad_alloc();
+
+            std::byte* buffer = block + headerSize;
+            GetHeader(buffer).large = large;
+            return buffer;
+        }
+
+        static void Deallocate(std::byte* buffer)
+        {
+            if (buffer == nullptr)
+                return;
+
+            const bool large = GetHeader(buffer).large;
+            std::byte* block = buffer - GetHeaderSize(large);
+            if (large)
+                LargeAlloc::Deallocate(block);
+            else
+                SmallAlloc::Deallocate(block);
+        }
+
+        static std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+            if (buffer == nullptr)
+                return Allocate(newSize);
+
+            const bool large = GetHeader(buffer).large;
+            const size_t headerSize = GetHeaderSize(large);
+            std::byte* block = buffer - headerSize;
+
+            if (large == (newSize >= Threshold))
+            {
+                std::byte* newBlock = large ? ReallocateWith<LargeAlloc>(block, oldSize + headerSize, newSize + headerSize)
+                                            : ReallocateWith<SmallAlloc>(block, oldSize + headerSize, newSize + headerSize);
+                return newBlock + headerSize;
+            }
+
+            std::byte* newBuffer = Allocate(newSize);
+            memcpy(newBuffer, buffer, (std::min)(oldSize, newSize));
+            Deallocate(buffer);
+            return newBuffer;
+        }
+
+    private:
+        static constexpr size_t SmallHeaderSize = GetAllocatorAlignment<SmallAlloc>();
+        static constexpr size_t LargeHeaderSize = (std::max)(GetAllocatorAlignment<LargeAlloc>(), SmallHeaderSize);
+
+        struct Header
+        {
+            bool large;
+        };
+
+        static_assert(sizeof(Header) <= SmallHeaderSize, "The tag must fit in the small allocator alignment");
+
+        static constexpr size_t GetHeaderSize(bool large)
+        {
+            return large ? LargeHeaderSize : SmallHeaderSize;
+        }
+
+        // The tag sits right before the buffer for both kinds of blocks.
+        static Header& GetHeader(std::byte* buffer)
+        {
+            return *reinterpret_cast<Header*>(buffer - SmallHeaderSize);
+        }
+
+        template <typename Alloc>
+        static std::byte* ReallocateWith(std::byte* block, size_t oldSize, size_t newSize)
+        {
+            std::byte* newBlock;
+            if constexpr (ReallocatingAllocator<Alloc>)
+            {
+                newBlock = Alloc::Reallocate(block, oldSize, newSize);
+            }
+            else
+            {
+                newBlock = Alloc::Allocate(newSize);
+                if (newBlock != nullptr)
+                {
+                    memcpy(newBlock, block, (std::min)(oldSize, newSize));
+                    Alloc::Deallocate(block);
+                }
+            }
+
+            if (newBlock == nullptr)
+                throw std::bad_alloc();
+            return newBlock;
+        }
+    };
+}
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <LLUtils/FileMapping.h>
+
+namespace LLUtils
+{
+    // Sequential read-only access to a file of any size through a sliding mapped window.
+    // At most 'windowSize' bytes (plus alignment slack) are mapped at a time.
+    //
+    //  MappedFileReader reader(path);
+    //  while (reader.Next())
+    //      Process(reader.GetWindow(), reader.GetWindowOffset());
+    class MappedFileReader
+    {
+    public:
+        static constexpr size_t DefaultWindowSize = size_t{ 64 } << 20;
+
+        // overlap - bytes of the previous window repeated at the start of the next one,
+        //           for records that may cross a window boundary.
+        MappedFileReader(const native_string_type& filePath, size_t windowSize = DefaultWindowSize, size_t overlap = 0)
+            : fMapping(filePath, FileMapping::Mode::ReadOnly, FileMapping::Window{ 0, 0 })
+            , fWindowSize(windowSize)
+            , fOverlap(overlap)
+        {
+            if (windowSize == 0 || overlap >= windowSize)
+                throw std::invalid_argument("Window size must be non zero and larger than the overlap");
+        }
+
+        // Map the next window, returns false once the end of the file is reached.
+        bool Next()
+        {
+            uintmax_t offset = fNextOffset;
+            if (fStarted && fMapping.GetSize() > 0)
+            {
+                const uintmax_t end = fMapping.GetViewOffset() + fMapping.GetSize();
+                if (end >= fMapping.GetFileSize())
+                {
+                    fMapping.MapWindow(fMapping.GetFileSize(), 0);
+                    return false;
+                }
+                offset = end - fOverlap;
+            }
+
+            fStarted = true;
+            if (offset >= fMapping.GetFileSize())
+            {
+                fMapping.MapWindow(fMapping.GetFileSize(), 0);
+                return false;
+            }
+
+            fMapping.MapWindow(offset, fWindowSize);
+            return true;
+        }
+
+        // The next call to Next() maps a window starting at 'offset'.
+        void Seek(uintmax_t offset)
+        {
+            if (offset > fMapping.GetFileSize())
+                throw std::runtime_error("Seek out of range");
+
+            fNextOffset = offset;
+            fStarted = false;
+            fMapping.MapWindow(offset, 0);
+        }
+
+        std::span<const std::byte> GetWindow() const
+        {
+            return { static_cast<const std::byte*>(fMapping.GetBuffer()), static_cast<size_t>(fMapping.GetSize()) };
+        }
+
+        uintmax_t GetWindowOffset() const
+        {
+            return fMapping.GetViewOffset();
+        }
+
+        uintmax_t GetFileSize() const
+        {
+            return fMapping.GetFileSize();
+        }
+
+        // Invoke 'func(std::span<const std::byte> window, uintmax_t offset)' for each window of the file.
+        template <typename Func>
+        static void ForEachWindow(const native_string_type& filePath, Func&& func, size_t windowSize = DefaultWindowSize, size_t overlap = 0)
+        {
+            MappedFileReader reader(filePath, windowSize, overlap);
+            while (reader.Next())
+                func(reader.GetWindow(), reader.GetWindowOffset());
+        }
+
+    private:
+        FileMapping fMapping;
+        size_t fWindowSize;
+        size_t fOverlap;
+        uintmax_t fNextOffset{};
+        bool fStarted = false;
+    };
+}
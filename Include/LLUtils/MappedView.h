@@ -0,0 +1,218 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Endian.h>
+#include <LLUtils/FileMapping.h>
+#include <LLUtils/Warnings.h>
+
+namespace LLUtils
+{
+    // Zero-copy view of an array of T stored in mapped memory, e.g. a FileMapping.
+    // Alignment and size are checked once on construction, like BufferBase::operator std::span<T>.
+    // The underlying memory must outlive the view.
+    template <typename T>
+    class MappedArray
+    {
+    public:
+        using value_type = T;
+
+        MappedArray(std::span<const std::byte> data) : fData(ReinterpretSpan<const T>(data.data(), data.size()))
+        {
+
+        }
+
+        // View 'count' elements starting at 'offset' bytes into the view of the mapping, by default up to its end.
+        MappedArray(const FileMapping& mapping, uintmax_t offset = 0, size_t count = std::numeric_limits<size_t>::max())
+            : MappedArray(Slice(mapping, offset, count))
+        {
+
+        }
+
+        const T& operator[](size_t index) const
+        {
+            return fData[index];
+        }
+
+        const T& at(size_t index) const
+        {
+            if (index >= fData.size())
+                throw std::out_of_range("MappedArray: index out of range");
+            return fData[index];
+        }
+
+        // The element converted from the given byte order to native.
+        template <std::endian Order>
+        T Load(size_t index) const
+        {
+            return Endian::Convert<Order>(fData[index]);
+        }
+
+        const T* data() const { return fData.data(); }
+        size_t size() const { return fData.size(); }
+        bool empty() const { return fData.empty(); }
+        auto begin() const { return fData.begin(); }
+        auto end() const { return fData.end(); }
+
+        operator std::span<const T>() const
+        {
+            return fData;
+        }
+
+    private:
+        static std::span<const std::byte> Slice(const FileMapping& mapping, uintmax_t offset, size_t count)
+        {
+            if (offset > mapping.GetSize())
+                throw std::runtime_error("MappedArray: offset is out of the mapped range");
+
+            const size_t available = static_cast<size_t>(mapping.GetSize() - offset);
+            size_t size = available - available % sizeof(T);
+            if (count != std::numeric_limits<size_t>::max())
+            {
+                if (count > available / sizeof(T))
+                    throw std::runtime_error("MappedArray: count exceeds the mapped range");
+                size = count * sizeof(T);
+            }
+
+            LLUTILS_DISABLE_WARNING_PUSH
+            LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+            return { static_cast<const std::byte*>(mapping.GetBuffer()) + offset, size };
+            LLUTILS_DISABLE_WARNING_POP
+        }
+
+    private:
+        std::span<const T> fData;
+    };
+
+    // Zero-copy view of a file format made of a 'Header' followed by fixed size records.
+    // Records are 'stride' bytes apart, which may be larger than sizeof(Record) for padded or versioned formats.
+    template <typename Header, typename Record>
+    class MappedRecords
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Record>, "Header and Record must be trivially copyable");
+
+        static constexpr size_t AllRecords = std::numeric_limits<size_t>::max();
+
+        // recordsOffset - offset of the first record from the start of the header.
+        // count - number of records, by default as many as fit in the data.
+        MappedRecords(std::span<const std::byte> data, size_t count = AllRecords, size_t stride = sizeof(Record), size_t recordsOffset = sizeof(Header))
+            : fData(data.data()), fStride(stride), fRecordsOffset(recordsOffset)
+        {
+            if (data.size() < sizeof(Header) || data.size() < recordsOffset)
+                throw std::runtime_error("MappedRecords: data is smaller than the header");
+
+            if (stride < sizeof(Record))
+                throw std::runtime_error("MappedRecords: stride is smaller than the record size");
+
+            const auto address = reinterpret_cast<std::uintptr_t>(fData);
+            if (address % alignof(Header) != 0 || (address + recordsOffset) % alignof(Record) != 0 || stride % alignof(Record) != 0)
+                throw std::runtime_error("MappedRecords: data is not properly aligned for the header or record type");
+
+            const size_t available = data.size() - recordsOffset;
+            const size_t fitting = available < sizeof(Record) ? 0 : (available - sizeof(Record)) / stride + 1;
+            if (count != AllRecords && count > fitting)
+                throw std::runtime_error("MappedRecords: record count exceeds the data size");
+
+            fCount = count == AllRecords ? fitting : count;
+        }
+
+        MappedRecords(const FileMapping& mapping, size_t count = AllRecords, size_t stride = sizeof(Record), size_t recordsOffset = sizeof(Header))
+            : MappedRecords(std::span<const std::byte>(static_cast<const std::byte*>(mapping.GetBuffer()), static_cast<size_t>(mapping.GetSize())), count, stride, recordsOffset)
+        {
+
+        }
+
+        const Header& GetHeader() const
+        {
+            return *reinterpret_cast<const Header*>(fData);
+        }
+
+        // A header field converted from the given byte order to native, e.g. LoadHeader<std::endian::big>(&Header::count).
+        template <std::endian Order, typename Field>
+        Field LoadHeader(Field Header::* field) const
+        {
+            return Endian::Convert<Order>(GetHeader().*field);
+        }
+
+        const Record& operator[](size_t index) const
+        {
+            LLUTILS_DISABLE_WARNING_PUSH
+            LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+            return *reinterpret_cast<const Record*>(fData + fRecordsOffset + index * fStride);
+            LLUTILS_DISABLE_WARNING_POP
+        }
+
+        const Record& at(size_t index) const
+        {
+            if (index >= fCount)
+                throw std::out_of_range("MappedRecords: index out of range");
+            return (*this)[index];
+        }
+
+        // A record field converted from the given byte order to native.
+        template <std::endian Order, typename Field>
+        Field Load(size_t index, Field Record::* field) const
+        {
+            return Endian::Convert<Order>((*this)[index].*field);
+        }
+
+        // Invoke 'func(const Record&)' for each record.
+        template <typename Func>
+        void ForEach(Func&& func) const
+        {
+            for (size_t i = 0; i < fCount; i++)
+                func((*this)[i]);
+        }
+
+        size_t size() const { return fCount; }
+        bool empty() const { return fCount == 0; }
+        size_t GetStride() const { return fStride; }
+
+        // Records are contiguous and can be viewed as a span.
+        bool IsContiguous() const
+        {
+            return fStride == sizeof(Record);
+        }
+
+        std::span<const Record> GetSpan() const
+        {
+            if (IsContiguous() == false)
+                throw std::logic_error("MappedRecords: records are not contiguous");
+            return { &(*this)[0], fCount };
+        }
+
+    private:
+        const std::byte* fData;
+        size_t fStride;
+        size_t fRecordsOffset;
+        size_t fCount{};
+    };
+}
@@ -0,0 +1,211 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <LLUtils/FileMapping.h>
+
+namespace LLUtils
+{
+    // Shares read-only mappings of the same file between users instead of mapping it again on every open.
+    // Entries are validated against the file identity (device, inode, size and modification time) on every lookup,
+    // so a replaced or modified file is mapped again.
+    // Unused entries are evicted in LRU order once the total mapped size exceeds the budget, mappings still
+    // referenced by callers stay valid until released.
+    class MappingCache
+    {
+    public:
+        static constexpr uintmax_t DefaultMaxBytes = uintmax_t{ 1 } << 30;
+
+        MappingCache(uintmax_t maxBytes = DefaultMaxBytes) : fMaxBytes(maxBytes)
+        {
+
+        }
+
+        MappingCache(const MappingCache&) = delete;
+        MappingCache& operator=(const MappingCache&) = delete;
+
+        static MappingCache& GetGlobal()
+        {
+            static MappingCache sCache;
+            return sCache;
+        }
+
+        std::shared_ptr<const FileMapping> Get(const std::filesystem::path& filePath)
+        {
+            const std::filesystem::path canonicalPath = std::filesystem::canonical(filePath);
+            const FileIdentity identity = GetFileIdentity(canonicalPath);
+
+            {
+                std::lock_guard lock(fMutex);
+                auto it = fEntries.find(canonicalPath.native());
+                if (it != fEntries.end())
+                {
+                    if (it->second->identity == identity)
+                    {
+                        fHits++;
+                        fLRU.splice(fLRU.begin(), fLRU, it->second);
+                        return it->second->mapping;
+                    }
+                    EraseImp(it);
+                }
+                fMisses++;
+            }
+
+            // Map outside the lock, concurrent misses of the same file may map it twice and the last one is cached.
+            auto mapping = std::make_shared<const FileMapping>(canonicalPath.native());
+
+            std::lock_guard lock(fMutex);
+            auto it = fEntries.find(canonicalPath.native());
+            if (it != fEntries.end())
+                EraseImp(it);
+
+            fLRU.push_front(Entry{ canonicalPath.native(), identity, mapping });
+            fEntries.emplace(canonicalPath.native(), fLRU.begin());
+            fMappedBytes += mapping->GetSize();
+            TrimImp(fMaxBytes);
+            return mapping;
+        }
+
+        // Remove the file from the cache, existing references stay valid.
+        void Invalidate(const std::filesystem::path& filePath)
+        {
+            std::error_code ec;
+            const std::filesystem::path canonicalPath = std::filesystem::canonical(filePath, ec);
+            std::lock_guard lock(fMutex);
+            auto it = fEntries.find(ec ? filePath.native() : canonicalPath.native());
+            if (it != fEntries.end())
+                EraseImp(it);
+        }
+
+        // Evict entries until the cached mappings take at most 'maxBytes'.
+        void Trim(uintmax_t maxBytes = 0)
+        {
+            std::lock_guard lock(fMutex);
+            TrimImp(maxBytes);
+        }
+
+        void Clear()
+        {
+            std::lock_guard lock(fMutex);
+            fEntries.clear();
+            fLRU.clear();
+            fMappedBytes = 0;
+        }
+
+        void SetMaxBytes(uintmax_t maxBytes)
+        {
+            std::lock_guard lock(fMutex);
+            fMaxBytes = maxBytes;
+            TrimImp(fMaxBytes);
+        }
+
+        uintmax_t GetMappedBytes() const
+        {
+            std::lock_guard lock(fMutex);
+            return fMappedBytes;
+        }
+
+        size_t GetEntryCount() const
+        {
+            std::lock_guard lock(fMutex);
+            return fEntries.size();
+        }
+
+        uint64_t GetHits() const
+        {
+            std::lock_guard lock(fMutex);
+            return fHits;
+        }
+
+        uint64_t GetMisses() const
+        {
+            std::lock_guard lock(fMutex);
+            return fMisses;
+        }
+
+    private:
+        struct FileIdentity
+        {
+            uintmax_t device{};
+            uintmax_t inode{};
+            uintmax_t size{};
+            int64_t modificationTime{};
+
+            bool operator==(const FileIdentity&) const = default;
+        };
+
+        struct Entry
+        {
+            native_string_type path;
+            FileIdentity identity;
+            std::shared_ptr<const FileMapping> mapping;
+        };
+
+        using LRUList = std::list<Entry>;
+        using EntryMap = std::unordered_map<native_string_type, LRUList::iterator>;
+
+        static FileIdentity GetFileIdentity(const std::filesystem::path& filePath)
+        {
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+            struct stat64 sb;
+            if (stat64(filePath.c_str(), &sb) == -1)
+                throw std::runtime_error("Cannot get file information");
+
+            return { static_cast<uintmax_t>(sb.st_dev), static_cast<uintmax_t>(sb.st_ino), static_cast<uintmax_t>(sb.st_size),
+                static_cast<int64_t>(sb.st_mtim.tv_sec) * 1'000'000'000 + sb.st_mtim.tv_nsec };
+#else
+            // The path is canonical so it identifies the file, the file index would require opening it.
+            return { 0, 0, std::filesystem::file_size(filePath),
+                static_cast<int64_t>(std::filesystem::last_write_time(filePath).time_since_epoch().count()) };
+#endif
+        }
+
+        void EraseImp(EntryMap::iterator it)
+        {
+            fMappedBytes -= it->second->mapping->GetSize();
+            fLRU.erase(it->second);
+            fEntries.erase(it);
+        }
+
+        void TrimImp(uintmax_t maxBytes)
+        {
+            // Keep the most recent entry even if it alone exceeds the budget.
+            while (fMappedBytes > maxBytes && fLRU.empty() == false && (maxBytes == 0 || fLRU.size() > 1))
+                EraseImp(fEntries.find(fLRU.back().path));
+        }
+
+    private:
+        mutable std::mutex fMutex;
+        LRUList fLRU;
+        EntryMap fEntries;
+        uintmax_t fMaxBytes;
+        uintmax_t fMappedBytes{};
+        uint64_t fHits{};
+        uint64_t fMisses{};
+    };
+}
@@ -0,0 +1,330 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <LLUtils/Buffer.h>
+#include <LLUtils/Platform.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define LLUTILS_MEMORY_COPY_X64 1
+    #include <immintrin.h>
+#else
+    #define LLUTILS_MEMORY_COPY_X64 0
+#endif
+
+namespace LLUtils
+{
+    // memcpy replacement for very large copies.
+    // Above the non-temporal threshold data is written with streaming stores that bypass the cache,
+    // above the parallel threshold the copy is also split across threads.
+    // Smaller copies go straight to memcpy.
+    // Including this header makes BufferBase use it for its large copies.
+    // The default thresholds are measured crossovers on a Xeon server, call Calibrate to measure the running machine instead.
+    class MemoryCopy
+    {
+    public:
+        enum class Method
+        {
+              Scalar
+            , StreamingSSE2
+            , StreamingAVX
+        };
+
+        static void Copy(void* dest, const void* src, size_t size)
+        {
+            const CopyFunction copy = size < sNonTemporalThreshold.load(std::memory_order_relaxed) ? &CopyScalar : GetCopyFunction();
+            const size_t maxThreads = sMaxThreads.load(std::memory_order_relaxed);
+            if (size >= sParallelThreshold.load(std::memory_order_relaxed) && maxThreads > 1)
+                CopyParallel(static_cast<std::byte*>(dest), static_cast<const std::byte*>(src), size, maxThreads, copy);
+            else
+                copy(dest, src, size);
+        }
+
+        // Times memcpy, the streaming copy and the parallel copy on this machine and sets both thresholds to the crossover points.
+        // Takes about a second and allocates 2 * CalibrationBytes.
+        static void Calibrate()
+        {
+            std::unique_ptr<std::byte[]> src = std::make_unique<std::byte[]>(CalibrationBytes);
+            std::unique_ptr<std::byte[]> dest = std::make_unique<std::byte[]>(CalibrationBytes);
+            memset(src.get(), 1, CalibrationBytes);
+            memset(dest.get(), 2, CalibrationBytes);
+
+            const CopyFunction streaming = GetCopyFunction();
+            size_t nonTemporalThreshold = SIZE_MAX;
+            if (streaming != &CopyScalar)
+            {
+                for (size_t size = 256 * 1024; size <= CalibrationBytes; size *= 2)
+                {
+                    if (MeasureCopy(streaming, dest.get(), src.get(), size) < MeasureCopy(&CopyScalar, dest.get(), src.get(), size))
+                    {
+                        nonTemporalThreshold = size;
+                        break;
+                    }
+                }
+            }
+
+            size_t parallelThreshold = SIZE_MAX;
+            const size_t maxThreads = sMaxThreads.load(std::memory_order_relaxed);
+            if (maxThreads > 1)
+            {
+                for (size_t size = 2 * MinBytesPerThread; size <= CalibrationBytes; size *= 2)
+                {
+                    const CopyFunction copy = size < nonTemporalThreshold ? &CopyScalar : streaming;
+                    const auto parallel = [maxThreads, copy](void* dest, const void* src, size_t size)
+                    {
+                        CopyParallel(static_cast<std::byte*>(dest), static_cast<const std::byte*>(src), size, maxThreads, copy);
+                    };
+
+                    if (MeasureCopy(parallel, dest.get(), src.get(), size) < MeasureCopy(copy, dest.get(), src.get(), size))
+                    {
+                        parallelThreshold = size;
+                        break;
+                    }
+                }
+            }
+
+            SetNonTemporalThreshold(nonTemporalThreshold);
+            SetParallelThreshold(parallelThreshold);
+        }
+
+        static void SetNonTemporalThreshold(size_t bytes)
+        {
+            sNonTemporalThreshold.store(bytes, std::memory_order_relaxed);
+        }
+
+        static size_t GetNonTemporalThreshold()
+        {
+            return sNonTemporalThreshold.load(std::memory_order_relaxed);
+        }
+
+        static void SetParallelThreshold(size_t bytes)
+        {
+            sParallelThreshold.store(bytes, std::memory_order_relaxed);
+        }
+
+        static size_t GetParallelThreshold()
+        {
+            return sParallelThreshold.load(std::memory_order_relaxed);
+        }
+
+        // 0 - use std::thread::hardware_concurrency.
+        static void SetMaxThreads(size_t maxThreads)
+        {
+            sMaxThreads.store(maxThreads == 0 ? DefaultMaxThreads() : maxThreads, std::memory_order_relaxed);
+        }
+
+        // The streaming method selected for this CPU.
+        static Method GetMethod()
+        {
+            static const Method sMethod = DetectMethod();
+            return sMethod;
+        }
+
+    private:
+        using CopyFunction = void (*)(void*, const void*, size_t);
+
+        // Each thread copies at least this much, smaller splits cost more in thread start up than they gain.
+        static constexpr size_t MinBytesPerThread = 8 * 1024 * 1024;
+        static constexpr size_t CalibrationBytes = 64 * 1024 * 1024;
+        static constexpr size_t PageSize = 4096;
+
+        // Best of several runs, in seconds, small sizes are repeated to get measurable runs.
+        template <typename Copy>
+        static double MeasureCopy(const Copy& copy, std::byte* dest, const std::byte* src, size_t size)
+        {
+            const size_t repeats = (std::max)(MinBytesPerThread / size, size_t{ 1 });
+            double best = 0;
+            for (int i = 0; i < 5; i++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (size_t r = 0; r < repeats; r++)
+                    copy(dest, src, size);
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                best = i == 0 ? elapsed : (std::min)(best, elapsed);
+            }
+            return best;
+        }
+
+        static size_t DefaultMaxThreads()
+        {
+            return (std::min)((std::max)(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{ 1 }), size_t{ 8 });
+        }
+
+        static Method DetectMethod()
+        {
+#if LLUTILS_MEMORY_COPY_X64
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx"))
+                return Method::StreamingAVX;
+    #endif
+            return Method::StreamingSSE2;
+#else
+            return Method::Scalar;
+#endif
+        }
+
+        static CopyFunction GetCopyFunction()
+        {
+            switch (GetMethod())
+            {
+#if LLUTILS_MEMORY_COPY_X64
+            case Method::StreamingAVX:
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+                return &CopyStreamingAVX;
+    #endif
+            case Method::StreamingSSE2:
+                return &CopyStreamingSSE2;
+#endif
+            default:
+                return &CopyScalar;
+            }
+        }
+
+        static void CopyScalar(void* dest, const void* src, size_t size)
+        {
+            memcpy(dest, src, size);
+        }
+
+#if LLUTILS_MEMORY_COPY_X64
+        static void CopyStreamingSSE2(void* destVoid, const void* srcVoid, size_t size)
+        {
+            std::byte* dest = static_cast<std::byte*>(destVoid);
+            const std::byte* src = static_cast<const std::byte*>(srcVoid);
+
+            // Align the destination, streaming stores require aligned addresses.
+            const size_t head = (std::min)(size, (16 - (reinterpret_cast<std::uintptr_t>(dest) & 15)) & 15);
+            memcpy(dest, src, head);
+            dest += head;
+            src += head;
+            size -= head;
+
+            const size_t blocks = size / 64;
+            for (size_t i = 0; i < blocks; i++)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + 48), d);
+                dest += 64;
+                src += 64;
+            }
+
+            _mm_sfence();
+            memcpy(dest, src, size - blocks * 64);
+        }
+
+    #if LLUTILS_COMPILER == LLUTILS_COMPILER_GNUC || LLUTILS_COMPILER == LLUTILS_COMPILER_CLANG
+        __attribute__((target("avx")))
+        static void CopyStreamingAVX(void* destVoid, const void* srcVoid, size_t size)
+        {
+            std::byte* dest = static_cast<std::byte*>(destVoid);
+            const std::byte* src = static_cast<const std::byte*>(srcVoid);
+
+            const size_t head = (std::min)(size, (32 - (reinterpret_cast<std::uintptr_t>(dest) & 31)) & 31);
+            memcpy(dest, src, head);
+            dest += head;
+            src += head;
+            size -= head;
+
+            const size_t blocks = size / 128;
+            for (size_t i = 0; i < blocks; i++)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 64));
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 96));
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest), a);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 32), b);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 64), c);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 96), d);
+                dest += 128;
+                src += 128;
+            }
+
+            _mm_sfence();
+            _mm256_zeroupper();
+            memcpy(dest, src, size - blocks * 128);
+        }
+    #endif
+#endif
+
+        static void CopyParallel(std::byte* dest, const std::byte* src, size_t size, size_t maxThreads, CopyFunction copy)
+        {
+            const size_t numThreads = std::clamp<size_t>(size / MinBytesPerThread, 1, maxThreads);
+            // Chunks end on destination page boundaries so threads never write to the same page.
+            const auto chunkEnd = [dest, size, numThreads](size_t index)
+            {
+                if (index == numThreads)
+                    return size;
+                const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(dest) + size / numThreads * index;
+                return static_cast<size_t>(((address + PageSize - 1) & ~std::uintptr_t{ PageSize - 1 }) - reinterpret_cast<std::uintptr_t>(dest));
+            };
+
+            const size_t firstEnd = chunkEnd(1);
+            std::vector<std::thread> threads;
+            threads.reserve(numThreads - 1);
+            size_t offset = firstEnd;
+            try
+            {
+                for (size_t index = 2; index <= numThreads; index++)
+                {
+                    const size_t end = chunkEnd(index);
+                    threads.emplace_back(copy, dest + offset, src + offset, end - offset);
+                    offset = end;
+                }
+            }
+            catch (...)
+            {
+                // Thread creation failed, wait for the started threads and copy the rest here.
+                for (std::thread& thread : threads)
+                    thread.join();
+                copy(dest + offset, src + offset, size - offset);
+                threads.clear();
+            }
+
+            copy(dest, src, firstEnd);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        // Streaming stores overtake memcpy once the copy no longer fits the L2 cache.
+        static inline std::atomic<size_t> sNonTemporalThreshold{ 4 * 1024 * 1024 };
+        // Two threads at MinBytesPerThread each, thread start up is ~20us against ~1ms per chunk.
+        static inline std::atomic<size_t> sParallelThreshold{ 2 * MinBytesPerThread };
+        static inline std::atomic<size_t> sMaxThreads{ DefaultMaxThreads() };
+        static inline const bool sInstalled = (BufferCopy::SetLargeCopy(&MemoryCopy::Copy), true);
+    };
+}
@@ -0,0 +1,300 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <LLUtils/Buffer.h>
+
+namespace LLUtils
+{
+    // Bump-pointer arena for short lived allocations that die together.
+    // Individual deallocations are no-ops, Reset() reclaims everything at once and keeps the chunks for reuse.
+    template <typename BackingAlloc = AlignedAlloc>
+    class MonotonicArenaBase
+    {
+    public:
+        static constexpr size_t DefaultAlignment = static_cast<size_t>(AlignedAlloc::Alignment);
+
+        // Sets the arena used by ArenaAlloc on the current thread for the lifetime of the scope.
+        class Scope
+        {
+        public:
+            Scope(MonotonicArenaBase& arena) : fPrevious(sCurrent)
+            {
+                sCurrent = &arena;
+            }
+
+            ~Scope()
+            {
+                sCurrent = fPrevious;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            MonotonicArenaBase* fPrevious;
+        };
+
+        explicit MonotonicArenaBase(size_t initialChunkSize = 64 * 1024) : fNextChunkSize(std::max<size_t>(initialChunkSize, DefaultAlignment))
+        {
+
+        }
+
+        MonotonicArenaBase(const MonotonicArenaBase&) = delete;
+        MonotonicArenaBase& operator=(const MonotonicArenaBase&) = delete;
+
+        ~MonotonicArenaBase()
+        {
+            for (const Chunk& chunk : fChunks)
+                BackingAlloc::Deallocate(chunk.data);
+        }
+
+        std::byte* Allocate(size_t size, size_t alignment = DefaultAlignment)
+        {
+            std::byte* result = TryBump(size, alignment);
+            if (result == nullptr)
+            {
+                NextChunk(size + alignment);
+                result = TryBump(size, alignment);
+            }
+
+            fLastAllocation = result;
+            fAllocatedBytes += size;
+            return result;
+        }
+
+        // Extends the most recent allocation in place when possible, otherwise allocates and copies.
+        std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+            if (buffer == nullptr)
+                return Allocate(newSize);
+
+            if (buffer == fLastAllocation && static_cast<size_t>(fEnd - buffer) >= newSize)
+            {
+                fCurrent = buffer + newSize;
+                fAllocatedBytes = fAllocatedBytes - oldSize + newSize;
+                return buffer;
+            }
+
+            std::byte* newBuffer = Allocate(newSize);
+            memcpy(newBuffer, buffer, (std::min)(oldSize, newSize));
+            return newBuffer;
+        }
+
+        // O(1), all memory handed out so far becomes invalid.
+        void Reset()
+        {
+            fCurrentChunk = 0;
+            fCurrent = fChunks.empty() ? nullptr : fChunks.front().data;
+            fEnd = fChunks.empty() ? nullptr : fChunks.front().data + fChunks.front().size;
+            fLastAllocation = nullptr;
+            fAllocatedBytes = 0;
+        }
+
+        // Reset and return all chunks but the first to the backing allocator.
+        void Release()
+        {
+            for (size_t i = 1; i < fChunks.size(); i++)
+                BackingAlloc::Deallocate(fChunks[i].data);
+            if (fChunks.size() > 1)
+                fChunks.resize(1);
+            Reset();
+        }
+
+        size_t GetAllocatedBytes() const
+        {
+            return fAllocatedBytes;
+        }
+
+        size_t GetReservedBytes() const
+        {
+            size_t total = 0;
+            for (const Chunk& chunk : fChunks)
+                total += chunk.size;
+            return total;
+        }
+
+        static MonotonicArenaBase* GetCurrent()
+        {
+            return sCurrent;
+        }
+
+    private:
+        struct Chunk
+        {
+            std::byte* data;
+            size_t size;
+        };
+
+        std::byte* TryBump(size_t size, size_t alignment)
+        {
+            if (fCurrent == nullptr)
+                return nullptr;
+
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(fCurrent);
+            const size_t padding = static_cast<size_t>(LLUtils::Utility::Align<std::uintptr_t>(address, alignment) - address);
+            if (padding > static_cast<size_t>(fEnd - fCurrent) || size > static_cast<size_t>(fEnd - fCurrent) - padding)
+                return nullptr;
+
+            std::byte* result = fCurrent + padding;
+            fCurrent = result + size;
+            return result;
+        }
+
+        void NextChunk(size_t minSize)
+        {
+            // Reuse chunks kept from before the last Reset.
+            while (fCurrentChunk + 1 < fChunks.size())
+            {
+                fCurrentChunk++;
+                if (fChunks[fCurrentChunk].size >= minSize)
+                {
+                    SetCurrentChunk(fCurrentChunk);
+                    return;
+                }
+            }
+
+            const size_t chunkSize = (std::max)(minSize, fNextChunkSize);
+            std::byte* data = BackingAlloc::Allocate(chunkSize);
+            if (data == nullptr)
+                throw std::bad_alloc();
+
+            fChunks.push_back({ data, chunkSize });
+            fNextChunkSize = chunkSize * 2;
+            SetCurrentChunk(fChunks.size() - 1);
+        }
+
+        void SetCurrentChunk(size_t index)
+        {
+            fCurrentChunk = index;
+            fCurrent = fChunks[index].data;
+            fEnd = fCurrent + fChunks[index].size;
+        }
+
+        std::vector<Chunk> fChunks;
+        size_t fCurrentChunk = 0;
+        size_t fNextChunkSize;
+        size_t fAllocatedBytes = 0;
+        std::byte* fCurrent = nullptr;
+        std::byte* fEnd = nullptr;
+        std::byte* fLastAllocation = nullptr;
+        static inline thread_local MonotonicArenaBase* sCurrent = nullptr;
+    };
+
+    using MonotonicArena = MonotonicArenaBase<>;
+
+
+    // BufferBase allocator policy drawing from the calling thread's current arena (see MonotonicArena::Scope).
+    // Buffers must not outlive the arena's next Reset.
+    template <typename Arena = MonotonicArena>
+    class ArenaAllocBase
+    {
+    public:
+        static constexpr int Alignment = AlignedAlloc::Alignment;
+
+        static std::byte* Allocate(size_t size)
+        {
+            return GetArena().Allocate(size);
+        }
+
+        static void Deallocate(std::byte*)
+        {
+
+        }
+
+        static std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+            return GetArena().Reallocate(buffer, oldSize, newSize);
+        }
+
+    private:
+        static Arena& GetArena()
+        {
+            Arena* arena = Arena::GetCurrent();
+            if (arena == nullptr)
+                throw std::logic_error("No active arena scope on this thread");
+            return *arena;
+        }
+    };
+
+    using ArenaAlloc = ArenaAllocBase<>;
+    using ArenaBuffer = BufferBase<ArenaAlloc>;
+
+
+    // Standard allocator adapter, e.g. std::vector<int, ArenaAllocator<int>> v(ArenaAllocator<int>(arena));
+    template <typename T, typename Arena = MonotonicArena>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = ArenaAllocator<U, Arena>;
+        };
+
+        ArenaAllocator(Arena& arena) noexcept : fArena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U, Arena>& rhs) noexcept : fArena(rhs.GetArena()) {}
+
+        T* allocate(size_t n)
+        {
+            if (n > SIZE_MAX / sizeof(T))
+                throw std::bad_array_new_length();
+            return reinterpret_cast<T*>(fArena->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept
+        {
+
+        }
+
+        Arena* GetArena() const noexcept
+        {
+            return fArena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U, Arena>& rhs) const noexcept
+        {
+            return fArena == rhs.GetArena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U, Arena>& rhs) const noexcept
+        {
+            return fArena != rhs.GetArena();
+        }
+
+    private:
+        Arena* fArena;
+    };
+}
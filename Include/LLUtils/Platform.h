@@ -110,6 +110,13 @@ namespace LLUtils
     #define LLUTILS_NORETURN
 #endif
 
+/* define LLUTILS_NO_UNIQUE_ADDRESS macro, MSVC ignores the standard attribute */
+#if defined(_MSC_VER)
+    #define LLUTILS_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define LLUTILS_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 /* Finds the current platform */
 #if (defined(__WIN32__) || defined(_WIN32)) && !defined(__ANDROID__)
     #include <sdkddkver.h>
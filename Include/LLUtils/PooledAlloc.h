@@ -0,0 +1,306 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <LLUtils/Buffer.h>
+
+namespace LLUtils
+{
+    // Size-class pooling allocator policy for BufferBase.
+    // Blocks are served from a thread-local free list per size class, refilled from / spilled to
+    // a process-wide pool. Sizes above MaxBlockSize bypass the pool and go to the backing allocator.
+    // usage: using PooledBuffer = BufferBase<PooledAlloc>;
+    template <typename BackingAlloc = AlignedAlloc>
+    class PooledAllocBase
+    {
+    public:
+        static constexpr int Alignment = static_cast<int>(GetAllocatorAlignment<BackingAlloc>());
+        static constexpr size_t MinBlockShift = 6;   // 64 bytes
+        static constexpr size_t MaxBlockShift = 20;  // 1 MB
+        static constexpr size_t MinBlockSize = size_t{ 1 } << MinBlockShift;
+        static constexpr size_t MaxBlockSize = size_t{ 1 } << MaxBlockShift;
+        static constexpr size_t NumSizeClasses = MaxBlockShift - MinBlockShift + 1;
+
+        // Upper bound of cached bytes per size class, per thread and in the global pool.
+        static constexpr size_t ThreadCacheBytesPerClass = 256 * 1024;
+        static constexpr size_t GlobalCacheBytesPerClass = 4 * 1024 * 1024;
+
+        static std::byte* Allocate(size_t size)
+        {
+            const uint32_t sizeClass = GetSizeClass(size);
+            if (sizeClass == UnpooledClass)
+                return AllocateBlock(size, UnpooledClass);
+
+            ThreadCache* cache = GetThreadCache();
+            if (cache == nullptr)
+                return AllocateBlock(ClassToSize(sizeClass), sizeClass);
+
+            FreeList& list = cache->lists[sizeClass];
+            if (list.head == nullptr)
+                GetGlobalPool().Acquire(sizeClass, list, MaxThreadBlocks(sizeClass) / 2);
+
+            if (list.head == nullptr)
+                return AllocateBlock(ClassToSize(sizeClass), sizeClass);
+
+            return list.Pop();
+        }
+
+        static void Deallocate(std::byte* buffer)
+        {
+            if (buffer == nullptr)
+                return;
+
+            const uint32_t sizeClass = GetHeader(buffer).sizeClass;
+            ThreadCache* cache = GetThreadCache();
+            // The thread cache is gone during thread exit, e.g. when freeing from another thread_local's destructor.
+            if (sizeClass == UnpooledClass || cache == nullptr)
+            {
+                FreeBlock(buffer);
+                return;
+            }
+
+            FreeList& list = cache->lists[sizeClass];
+            list.Push(buffer);
+            if (list.count > MaxThreadBlocks(sizeClass))
+                GetGlobalPool().Release(sizeClass, list, list.count / 2);
+        }
+
+        static std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+            if (buffer == nullptr)
+                return Allocate(newSize);
+
+            const uint32_t sizeClass = GetHeader(buffer).sizeClass;
+            const uint32_t newSizeClass = GetSizeClass(newSize);
+
+            // Still fits the current block.
+            if (sizeClass != UnpooledClass && sizeClass == newSizeClass)
+                return buffer;
+
+            if constexpr (ReallocatingAllocator<BackingAlloc>)
+            {
+                if (sizeClass == UnpooledClass && newSizeClass == UnpooledClass)
+                {
+                    std::byte* block = BackingAlloc::Reallocate(buffer - HeaderSize, oldSize + HeaderSize, newSize + HeaderSize);
+                    if (block == nullptr)
+                        throw std::bad_alloc();
+                    return block + HeaderSize;
+                }
+            }
+
+            std::byte* newBuffer = Allocate(newSize);
+            memcpy(newBuffer, buffer, (std::min)(oldSize, newSize));
+            Deallocate(buffer);
+            return newBuffer;
+        }
+
+        // Return all blocks cached by the calling thread to the global pool.
+        static void TrimThreadCache()
+        {
+            ThreadCache* cache = GetThreadCache();
+            if (cache == nullptr)
+                return;
+
+            for (uint32_t i = 0; i < NumSizeClasses; i++)
+                GetGlobalPool().Release(i, cache->lists[i], cache->lists[i].count);
+        }
+
+        // Release all blocks held by the global pool back to the backing allocator.
+        // Blocks cached by threads are not affected, call TrimThreadCache on those threads first.
+        static void Trim()
+        {
+            GetGlobalPool().Trim();
+        }
+
+        // Bytes currently cached in the global pool, not including thread caches.
+        static size_t GetGlobalCachedBytes()
+        {
+            return GetGlobalPool().GetCachedBytes();
+        }
+
+    private:
+        static constexpr uint32_t UnpooledClass = 0xFFFFFFFF;
+        static constexpr size_t HeaderSize = static_cast<size_t>(Alignment);
+
+        struct BlockHeader
+        {
+            uint32_t sizeClass;
+        };
+
+        static_assert(sizeof(BlockHeader) <= HeaderSize, "Block header must fit in the allocator alignment");
+
+        struct FreeList
+        {
+            std::byte* head = nullptr;
+            size_t count = 0;
+
+            void Push(std::byte* block)
+            {
+                *reinterpret_cast<std::byte**>(block) = head;
+                head = block;
+                count++;
+            }
+
+            std::byte* Pop()
+            {
+                std::byte* block = head;
+                head = *reinterpret_cast<std::byte**>(block);
+                count--;
+                return block;
+            }
+        };
+
+        class GlobalPool
+        {
+        public:
+            void Acquire(uint32_t sizeClass, FreeList& dest, size_t maxBlocks)
+            {
+                std::lock_guard lock(fMutexes[sizeClass]);
+                FreeList& source = fLists[sizeClass];
+                while (maxBlocks-- > 0 && source.head != nullptr)
+                    dest.Push(source.Pop());
+            }
+
+            void Release(uint32_t sizeClass, FreeList& source, size_t numBlocks)
+            {
+                const size_t maxBlocks = GlobalCacheBytesPerClass / ClassToSize(sizeClass);
+                std::lock_guard lock(fMutexes[sizeClass]);
+                FreeList& dest = fLists[sizeClass];
+                while (numBlocks-- > 0 && source.head != nullptr)
+                {
+                    std::byte* block = source.Pop();
+                    if (dest.count < maxBlocks)
+                        dest.Push(block);
+                    else
+                        FreeBlock(block);
+                }
+            }
+
+            void Trim()
+            {
+                for (uint32_t i = 0; i < NumSizeClasses; i++)
+                {
+                    std::lock_guard lock(fMutexes[i]);
+                    while (fLists[i].head != nullptr)
+                        FreeBlock(fLists[i].Pop());
+                }
+            }
+
+            size_t GetCachedBytes()
+            {
+                size_t total = 0;
+                for (uint32_t i = 0; i < NumSizeClasses; i++)
+                {
+                    std::lock_guard lock(fMutexes[i]);
+                    total += fLists[i].count * ClassToSize(i);
+                }
+                return total;
+            }
+
+        private:
+            std::array<std::mutex, NumSizeClasses> fMutexes;
+            std::array<FreeList, NumSizeClasses> fLists;
+        };
+
+        struct ThreadCache
+        {
+            std::array<FreeList, NumSizeClasses> lists;
+
+            ~ThreadCache()
+            {
+                for (uint32_t i = 0; i < NumSizeClasses; i++)
+                    GetGlobalPool().Release(i, lists[i], lists[i].count);
+                sThreadCacheDestroyed = true;
+            }
+        };
+
+        // Trivially destructible, so it stays valid after the thread cache is destroyed.
+        static inline thread_local bool sThreadCacheDestroyed = false;
+
+        static GlobalPool& GetGlobalPool()
+        {
+            // Intentionally leaked, thread caches may be flushed into it during static destruction.
+            static GlobalPool* sGlobalPool = new GlobalPool();
+            return *sGlobalPool;
+        }
+
+        // nullptr once the calling thread's cache has been destroyed.
+        static ThreadCache* GetThreadCache()
+        {
+            if (sThreadCacheDestroyed)
+                return nullptr;
+
+            thread_local ThreadCache sThreadCache;
+            return &sThreadCache;
+        }
+
+        static constexpr size_t ClassToSize(uint32_t sizeClass)
+        {
+            return size_t{ 1 } << (sizeClass + MinBlockShift);
+        }
+
+        static constexpr size_t MaxThreadBlocks(uint32_t sizeClass)
+        {
+            const size_t blocks = ThreadCacheBytesPerClass / ClassToSize(sizeClass);
+            return blocks < 2 ? 2 : blocks;
+        }
+
+        static uint32_t GetSizeClass(size_t size)
+        {
+            if (size > MaxBlockSize)
+                return UnpooledClass;
+
+            if (size <= MinBlockSize)
+                return 0;
+
+            return static_cast<uint32_t>(std::bit_width(size - 1) - MinBlockShift);
+        }
+
+        static BlockHeader& GetHeader(std::byte* buffer)
+        {
+            return *reinterpret_cast<BlockHeader*>(buffer - HeaderSize);
+        }
+
+        static std::byte* AllocateBlock(size_t size, uint32_t sizeClass)
+        {
+            std::byte* block = BackingAlloc::Allocate(size + HeaderSize);
+            if (block == nullptr)
+                throw std::bad_alloc();
+
+            std::byte* buffer = block + HeaderSize;
+            GetHeader(buffer).sizeClass = sizeClass;
+            return buffer;
+        }
+
+        static void FreeBlock(std::byte* buffer)
+        {
+            BackingAlloc::Deallocate(buffer - HeaderSize);
+        }
+    };
+
+    using PooledAlloc = PooledAllocBase<>;
+}
@@ -0,0 +1,237 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <LLUtils/Buffer.h>
+
+namespace LLUtils
+{
+    template <typename BufferType>
+    class BufferSliceBase;
+
+    // Immutable, atomically reference counted buffer.
+    // Takes ownership of a buffer without copying, copies of SharedBuffer share the same payload.
+    template <typename BufferType = Buffer>
+    class SharedBufferBase
+    {
+    public:
+        using Slice_t = BufferSliceBase<BufferType>;
+
+        SharedBufferBase() = default;
+
+        explicit SharedBufferBase(BufferType&& buffer) : fControl(new ControlBlock(std::move(buffer)))
+        {
+
+        }
+
+        SharedBufferBase(const SharedBufferBase& rhs) : fControl(rhs.fControl)
+        {
+            AddRef();
+        }
+
+        SharedBufferBase(SharedBufferBase&& rhs) noexcept : fControl(rhs.fControl)
+        {
+            rhs.fControl = nullptr;
+        }
+
+        SharedBufferBase& operator=(const SharedBufferBase& rhs)
+        {
+            if (fControl != rhs.fControl)
+            {
+                Release();
+                fControl = rhs.fControl;
+                AddRef();
+            }
+            return *this;
+        }
+
+        SharedBufferBase& operator=(SharedBufferBase&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                Release();
+                fControl = rhs.fControl;
+                rhs.fControl = nullptr;
+            }
+            return *this;
+        }
+
+        ~SharedBufferBase()
+        {
+            Release();
+        }
+
+        bool operator==(std::nullptr_t) const
+        {
+            return fControl == nullptr;
+        }
+
+        bool operator!=(std::nullptr_t) const
+        {
+            return fControl != nullptr;
+        }
+
+        const std::byte* data() const
+        {
+            return fControl != nullptr ? fControl->buffer.data() : nullptr;
+        }
+
+        size_t size() const
+        {
+            return fControl != nullptr ? fControl->buffer.size() : 0;
+        }
+
+        size_t UseCount() const
+        {
+            return fControl != nullptr ? fControl->refCount.load(std::memory_order_relaxed) : 0;
+        }
+
+        // Zero-copy view over [offset, offset + length), keeps the payload alive.
+        Slice_t Slice(size_t offset, size_t length) const
+        {
+            if (offset > size() || length > size() - offset)
+                throw std::runtime_error("Slice out of range");
+
+            return Slice_t(*this, offset, length);
+        }
+
+        Slice_t Slice(size_t offset = 0) const
+        {
+            if (offset > size())
+                throw std::runtime_error("Slice out of range");
+
+            return Slice_t(*this, offset, size() - offset);
+        }
+
+        // Deep copy into a new, mutable buffer.
+        BufferType Clone() const
+        {
+            return BufferType(data(), size());
+        }
+
+        template<typename T>
+        explicit operator std::span<const T>() const
+        {
+            return ReinterpretSpan<const T>(data(), size());
+        }
+
+    private:
+        struct ControlBlock
+        {
+            ControlBlock(BufferType&& buf) : buffer(std::move(buf)) {}
+            std::atomic<size_t> refCount{ 1 };
+            const BufferType buffer;
+        };
+
+        void AddRef()
+        {
+            if (fControl != nullptr)
+                fControl->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Release()
+        {
+            if (fControl != nullptr && fControl->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete fControl;
+            fControl = nullptr;
+        }
+
+        ControlBlock* fControl = nullptr;
+    };
+
+
+    // Offset/length view into a SharedBuffer, holds a reference to the underlying payload.
+    template <typename BufferType = Buffer>
+    class BufferSliceBase
+    {
+    public:
+        using SharedBuffer_t = SharedBufferBase<BufferType>;
+
+        BufferSliceBase() = default;
+
+        BufferSliceBase(SharedBuffer_t owner, size_t offset, size_t length) : fOwner(std::move(owner)), fOffset(offset), fLength(length)
+        {
+            if (fOffset > fOwner.size() || fLength > fOwner.size() - fOffset)
+                throw std::runtime_error("Slice out of range");
+        }
+
+        const std::byte* data() const
+        {
+            LLUTILS_DISABLE_WARNING_PUSH
+            LLUTILS_DISABLE_WARNING_UNSAFE_BUFFER_USAGE
+            return fOwner.data() != nullptr ? fOwner.data() + fOffset : nullptr;
+            LLUTILS_DISABLE_WARNING_POP
+        }
+
+        size_t size() const
+        {
+            return fLength;
+        }
+
+        size_t GetOffset() const
+        {
+            return fOffset;
+        }
+
+        const SharedBuffer_t& GetOwner() const
+        {
+            return fOwner;
+        }
+
+        // Sub-slice relative to this slice.
+        BufferSliceBase Slice(size_t offset, size_t length) const
+        {
+            if (offset > fLength || length > fLength - offset)
+                throw std::runtime_error("Slice out of range");
+
+            return BufferSliceBase(fOwner, fOffset + offset, length);
+        }
+
+        BufferType Clone() const
+        {
+            return BufferType(data(), size());
+        }
+
+        operator std::span<const std::byte>() const
+        {
+            return std::span<const std::byte>(data(), size());
+        }
+
+        template<typename T>
+        explicit operator std::span<const T>() const
+        {
+            return ReinterpretSpan<const T>(data(), size());
+        }
+
+    private:
+        SharedBuffer_t fOwner;
+        size_t fOffset = 0;
+        size_t fLength = 0;
+    };
+
+    using SharedBuffer = SharedBufferBase<Buffer>;
+    using BufferSlice = BufferSliceBase<Buffer>;
+}
@@ -0,0 +1,289 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <LLUtils/Platform.h>
+#include <LLUtils/EnumClassBitwise.h>
+
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace LLUtils
+{
+#if LLUTILS_PLATFORM == LLUTILS_PLATFORM_LINUX
+    // Anonymous shared memory (memfd) that can be mapped by other processes through its file descriptor.
+    // Pass GetFd() to a child process (the descriptor is close-on-exec, use DuplicateFd to inherit it,
+    // or send it over a unix socket) and open it there with FromFd. Both sides then access the same pages.
+    class SharedMemoryRegion
+    {
+    public:
+        // Seals restrict what any process can do with the memory from now on, see fcntl(F_ADD_SEALS).
+        enum class Seals : unsigned int
+        {
+              None        = 0
+            , Seal        = F_SEAL_SEAL   // No further seals can be added.
+            , Shrink      = F_SEAL_SHRINK
+            , Grow        = F_SEAL_GROW
+            , Write       = F_SEAL_WRITE  // The content is immutable, the region is remapped read-only.
+#ifdef F_SEAL_FUTURE_WRITE
+            , FutureWrite = F_SEAL_FUTURE_WRITE // New writable mappings are refused, existing ones keep writing.
+#endif
+        };
+        LLUTILS_DEFINE_ENUM_CLASS_FLAG_OPERATIONS_IN_CLASS(Seals)
+
+        SharedMemoryRegion() = default;
+
+        explicit SharedMemoryRegion(size_t size, const char* name = "LLUtils::SharedMemoryRegion")
+        {
+            fFd = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+            if (fFd == -1)
+                throw std::runtime_error("Cannot create shared memory");
+
+            if (ftruncate(fFd, static_cast<off_t>(size)) == -1)
+            {
+                Close();
+                throw std::runtime_error("Cannot size shared memory");
+            }
+
+            fSize = size;
+            Map(true);
+        }
+
+        // Create a region starting with a 'Header', followed by 'payloadSize' bytes, see GetHeader and GetPayload.
+        template <typename Header>
+        static SharedMemoryRegion Create(size_t payloadSize, const Header& header = {}, const char* name = "LLUtils::SharedMemoryRegion")
+        {
+            static_assert(std::is_trivially_copyable_v<Header>, "Header must be trivially copyable to be shared between processes");
+            SharedMemoryRegion region(GetPayloadOffset<Header>() + payloadSize, name);
+            new (region.fData) Header(header);
+            return region;
+        }
+
+        // Take ownership of a descriptor received from another process.
+        // If the region is write sealed it is mapped read-only.
+        static SharedMemoryRegion FromFd(int fd)
+        {
+            SharedMemoryRegion region;
+            region.fFd = fd;
+
+            struct stat sb;
+            if (fstat(fd, &sb) == -1)
+                throw std::runtime_error("Cannot get shared memory information");
+
+            region.fSize = static_cast<size_t>(sb.st_size);
+            const Seals seals = region.GetSeals();
+            region.Map((seals & (Seals::Write | FutureWriteSeal())) == Seals::None);
+            return region;
+        }
+
+        SharedMemoryRegion(SharedMemoryRegion&& rhs) noexcept
+        {
+            *this = std::move(rhs);
+        }
+
+        SharedMemoryRegion& operator=(SharedMemoryRegion&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                Close();
+                fFd = std::exchange(rhs.fFd, -1);
+                fData = std::exchange(rhs.fData, nullptr);
+                fSize = std::exchange(rhs.fSize, 0);
+                fWritable = std::exchange(rhs.fWritable, false);
+            }
+            return *this;
+        }
+
+        SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+        SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+        ~SharedMemoryRegion()
+        {
+            Close();
+        }
+
+        void Close()
+        {
+            if (fData != nullptr)
+                munmap(fData, fSize);
+            if (fFd != -1)
+                close(fFd);
+
+            fData = nullptr;
+            fSize = 0;
+            fFd = -1;
+            fWritable = false;
+        }
+
+        std::byte* data() const
+        {
+            return fData;
+        }
+
+        size_t size() const
+        {
+            return fSize;
+        }
+
+        bool IsWritable() const
+        {
+            return fWritable;
+        }
+
+        // Valid for the lifetime of the region, close-on-exec.
+        int GetFd() const
+        {
+            return fFd;
+        }
+
+        // A new descriptor of the region without close-on-exec, to be inherited by a child process.
+        // The caller owns the returned descriptor.
+        int DuplicateFd() const
+        {
+            const int fd = dup(fFd);
+            if (fd == -1)
+                throw std::runtime_error("Cannot duplicate shared memory descriptor");
+            return fd;
+        }
+
+        Seals GetSeals() const
+        {
+            const int seals = fcntl(fFd, F_GET_SEALS);
+            if (seals == -1)
+                throw std::runtime_error("Cannot get shared memory seals");
+            return static_cast<Seals>(seals);
+        }
+
+        // Write sealing requires that no shared mapping could be made writable, so this region is unmapped while
+        // sealing and mapped read-only afterwards. Fails if another process still has the region mapped writable.
+        void AddSeals(Seals seals)
+        {
+            const bool remap = (seals & Seals::Write) == Seals::Write && fData != nullptr;
+            if (remap)
+            {
+                munmap(fData, fSize);
+                fData = nullptr;
+            }
+
+            const bool sealed = fcntl(fFd, F_ADD_SEALS, static_cast<int>(seals)) != -1;
+            if (remap)
+                Map(sealed == false && fWritable);
+
+            if (sealed == false)
+                throw std::runtime_error("Cannot seal shared memory");
+        }
+
+        // Throws on read-only regions, use the const overload to read them.
+        template <typename Header>
+        Header& GetHeader()
+        {
+            RequireWritable();
+            return const_cast<Header&>(std::as_const(*this).template GetHeader<Header>());
+        }
+
+        template <typename Header>
+        const Header& GetHeader() const
+        {
+            static_assert(std::is_trivially_copyable_v<Header>, "Header must be trivially copyable to be shared between processes");
+            if (fSize < sizeof(Header))
+                throw std::runtime_error("Shared memory is smaller than its header");
+            return *std::launder(reinterpret_cast<const Header*>(fData));
+        }
+
+        // The bytes following 'Header', aligned to at least the fundamental alignment.
+        // Throws on read-only regions, use the const overload to read them.
+        template <typename Header>
+        std::span<std::byte> GetPayload()
+        {
+            RequireWritable();
+            const std::span<const std::byte> payload = std::as_const(*this).template GetPayload<Header>();
+            return { const_cast<std::byte*>(payload.data()), payload.size() };
+        }
+
+        template <typename Header>
+        std::span<const std::byte> GetPayload() const
+        {
+            const size_t offset = GetPayloadOffset<Header>();
+            if (fSize < offset)
+                throw std::runtime_error("Shared memory is smaller than its header");
+            return { fData + offset, fSize - offset };
+        }
+
+        template <typename Header>
+        static constexpr size_t GetPayloadOffset()
+        {
+            constexpr size_t alignment = (std::max)(alignof(Header), alignof(std::max_align_t));
+            return (sizeof(Header) + alignment - 1) / alignment * alignment;
+        }
+
+    private:
+        static constexpr Seals FutureWriteSeal()
+        {
+#ifdef F_SEAL_FUTURE_WRITE
+            return Seals::FutureWrite;
+#else
+            return Seals::None;
+#endif
+        }
+
+        void RequireWritable() const
+        {
+            if (fWritable == false)
+                throw std::runtime_error("Shared memory is mapped read-only");
+        }
+
+        void Map(bool writable)
+        {
+            fWritable = writable;
+            // An empty memfd can't be mapped.
+            if (fSize == 0)
+                return;
+
+            void* data = mmap(nullptr, fSize, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fFd, 0);
+            if (data == MAP_FAILED)
+            {
+                Close();
+                throw std::runtime_error("Cannot map shared memory");
+            }
+            fData = static_cast<std::byte*>(data);
+        }
+
+    private:
+        int fFd = -1;
+        std::byte* fData = nullptr;
+        size_t fSize{};
+        bool fWritable = false;
+    };
+#endif
+}
@@ -0,0 +1,216 @@
+/*
+Copyright (c) 2026 Lior Lahav
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <LLUtils/Buffer.h>
+
+namespace LLUtils
+{
+    // Allocation statistics snapshot, see TrackingAlloc::GetSnapshot.
+    struct AllocationStats
+    {
+        // Power of two buckets, bucket i counts allocations of size in [2^(i-1), 2^i), bucket 0 counts empty allocations.
+        static constexpr size_t NumHistogramBuckets = 48;
+
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        uint64_t reallocations = 0;
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t totalAllocatedBytes = 0;
+        std::array<uint64_t, NumHistogramBuckets> histogram{};
+
+        uint64_t GetLiveAllocations() const
+        {
+            return allocations - deallocations;
+        }
+    };
+
+
+    // Instrumentation decorator for BufferBase allocator policies.
+    // Counters are sharded per thread to avoid contention, a snapshot sums all shards.
+    // Live bytes are a single counter so the peak is exact, it costs one shared atomic add per allocation and deallocation.
+    // usage: using TrackedBuffer = BufferBase<TrackingAlloc<AlignedAlloc>>;
+    // Tag allows separate statistics for the same inner allocator.
+    template <typename Inner = DefaultAllocator, typename Tag = void>
+    class TrackingAlloc
+    {
+    public:
+        static constexpr int Alignment = static_cast<int>(GetAllocatorAlignment<Inner>());
+
+        static std::byte* Allocate(size_t size)
+        {
+            std::byte* block = Inner::Allocate(size + HeaderSize);
+            if (block == nullptr)
+                return nullptr;
+
+            reinterpret_cast<Header*>(block)->size = size;
+            OnAllocate(size);
+            return block + HeaderSize;
+        }
+
+        static void Deallocate(std::byte* buffer)
+        {
+            if (buffer == nullptr)
+                return;
+
+            std::byte* block = buffer - HeaderSize;
+            OnDeallocate(reinterpret_cast<Header*>(block)->size);
+            Inner::Deallocate(block);
+        }
+
+        static std::byte* Reallocate(std::byte* buffer, size_t oldSize, size_t newSize)
+        {
+            if (buffer == nullptr)
+                return Allocate(newSize);
+
+            std::byte* block = buffer - HeaderSize;
+            const size_t trackedSize = reinterpret_cast<Header*>(block)->size;
+            std::byte* newBlock;
+            if constexpr (ReallocatingAllocator<Inner>)
+            {
+                newBlock = Inner::Reallocate(block, oldSize + HeaderSize, newSize + HeaderSize);
+            }
+            else
+            {
+                newBlock = Inner::Allocate(newSize + HeaderSize);
+                if (newBlock != nullptr)
+                {
+                    memcpy(newBlock + HeaderSize, buffer, (std::min)(oldSize, newSize));
+                    Inner::Deallocate(block);
+                }
+            }
+
+            if (newBlock == nullptr)
+                return nullptr;
+
+            reinterpret_cast<Header*>(newBlock)->size = newSize;
+            Shard& shard = GetShard();
+            shard.reallocations.fetch_add(1, std::memory_order_relaxed);
+            if (newSize > trackedSize)
+            {
+                shard.totalAllocatedBytes.fetch_add(newSize - trackedSize, std::memory_order_relaxed);
+                AddLiveBytes(newSize - trackedSize);
+            }
+            else
+            {
+                sLiveBytes.fetch_sub(trackedSize - newSize, std::memory_order_relaxed);
+            }
+            return newBlock + HeaderSize;
+        }
+
+        static AllocationStats GetSnapshot()
+        {
+            AllocationStats stats;
+            for (const Shard& shard : sShards)
+            {
+                stats.allocations += shard.allocations.load(std::memory_order_relaxed);
+                stats.deallocations += shard.deallocations.load(std::memory_order_relaxed);
+                stats.reallocations += shard.reallocations.load(std::memory_order_relaxed);
+                stats.totalAllocatedBytes += shard.totalAllocatedBytes.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < AllocationStats::NumHistogramBuckets; i++)
+                    stats.histogram[i] += shard.histogram[i].load(std::memory_order_relaxed);
+            }
+
+            stats.liveBytes = sLiveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes = (std::max)(sPeakBytes.load(std::memory_order_relaxed), stats.liveBytes);
+            return stats;
+        }
+
+        // Reset the peak to the current live bytes, e.g. at the start of a measurement window.
+        static void ResetPeak()
+        {
+            sPeakBytes.store(sLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t NumShards = 16;
+        static constexpr size_t HeaderSize = static_cast<size_t>(Alignment);
+
+        struct Header
+        {
+            size_t size;
+        };
+
+        static_assert(sizeof(Header) <= HeaderSize, "Allocation header must fit in the allocator alignment");
+
+        // Each shard sits on its own cache line.
+        struct alignas(64) Shard
+        {
+            std::atomic<uint64_t> allocations{};
+            std::atomic<uint64_t> deallocations{};
+            std::atomic<uint64_t> reallocations{};
+            std::atomic<uint64_t> totalAllocatedBytes{};
+            std::array<std::atomic<uint64_t>, AllocationStats::NumHistogramBuckets> histogram{};
+        };
+
+        static Shard& GetShard()
+        {
+            static std::atomic<size_t> sNextShard{};
+            thread_local size_t sShardIndex = sNextShard.fetch_add(1, std::memory_order_relaxed) % NumShards;
+            return sShards[sShardIndex];
+        }
+
+        static size_t GetBucket(size_t size)
+        {
+            return (std::min)(static_cast<size_t>(std::bit_width(size)), AllocationStats::NumHistogramBuckets - 1);
+        }
+
+        static void OnAllocate(size_t size)
+        {
+            Shard& shard = GetShard();
+            shard.allocations.fetch_add(1, std::memory_order_relaxed);
+            shard.totalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+            shard.histogram[GetBucket(size)].fetch_add(1, std::memory_order_relaxed);
+            AddLiveBytes(size);
+        }
+
+        static void OnDeallocate(size_t size)
+        {
+            Shard& shard = GetShard();
+            shard.deallocations.fetch_add(1, std::memory_order_relaxed);
+            sLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        // The peak is only written when it's exceeded, so steady state allocations don't contend on it.
+        static void AddLiveBytes(size_t size)
+        {
+            const uint64_t live = sLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+            uint64_t peak = sPeakBytes.load(std::memory_order_relaxed);
+            while (live > peak && sPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed) == false)
+            {
+            }
+        }
+
+        static inline std::array<Shard, NumShards> sShards{};
+        alignas(64) static inline std::atomic<uint64_t> sLiveBytes{};
+        alignas(64) static inline std::atomic<uint64_t> sPeakBytes{};
+    };
+}